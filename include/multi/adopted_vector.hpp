@@ -0,0 +1,319 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include <multi/ndindex.hpp>
+#include <multi/third_party/mdspan.hpp>
+
+namespace multi
+{
+// Hyper-rectangular storage which takes ownership of an existing buffer, e.g. one allocated by another library,
+// without copying. The deleter is called with the buffer on destruction unless it is given up by release(). Views
+// and the algorithms accept it as they accept vector.
+template <
+  typename    _type      ,
+  std::size_t _dimensions,
+  typename    _layout    = std::experimental::layout_right,
+  typename    _deleter   = std::function<void(_type*)>>
+class adopted_vector
+{
+public:
+  using storage_type           = std::unique_ptr<_type, _deleter>;
+  using span_type              = std::experimental::mdspan<_type, std::experimental::dextents<_dimensions>, _layout>;
+  using mapping_type           = typename span_type::mapping_type;
+  using extents_type           = typename span_type::extents_type;
+  using deleter_type           = _deleter;
+
+  using value_type             = _type;
+  using size_type              = std::size_t;
+  using difference_type        = std::ptrdiff_t;
+  using reference              = value_type&;
+  using const_reference        = const value_type&;
+  using pointer                = value_type*;
+  using const_pointer          = const value_type*;
+  using iterator               = pointer;
+  using const_iterator         = const_pointer;
+  using reverse_iterator       = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  using indexed_type           = indexed_range<span_type>;
+  using const_indexed_type     = indexed_range<span_type, const_reference>;
+
+  using multi_size_type        = std::array<size_type, _dimensions>;
+
+  static_assert(mapping_type::is_always_contiguous(), "The layout must be contiguous.");
+
+  constexpr          adopted_vector() = default;
+  constexpr          adopted_vector(pointer data, const multi_size_type& size, deleter_type deleter)
+  : storage_(data, std::move(deleter)), span_(data, mapping_type(extents_type(size)))
+  {
+
+  }
+  template <size_type _d = _dimensions, typename = std::enable_if_t<_d == 1>>
+  constexpr          adopted_vector(pointer data, size_type              size, deleter_type deleter)
+  : adopted_vector(data, multi_size_type {size}, std::move(deleter))
+  {
+
+  }
+
+  constexpr          adopted_vector(const adopted_vector&  that) = delete;
+  constexpr          adopted_vector(      adopted_vector&& temp) noexcept
+  : storage_(std::move(temp.storage_)), span_(std::exchange(temp.span_, {}))
+  {
+
+  }
+
+  constexpr         ~adopted_vector() = default;
+
+  constexpr adopted_vector&        operator=    (const adopted_vector&  that) = delete;
+  constexpr adopted_vector&        operator=    (      adopted_vector&& temp) noexcept
+  {
+    if (this != &temp)
+    {
+      storage_ = std::move(temp.storage_);
+      span_    = std::exchange(temp.span_, {});
+    }
+    return *this;
+  }
+
+  // Element access.
+
+  constexpr reference              at           (size_type              position)
+  {
+    check_bounds(position);
+    return data()[position];
+  }
+  constexpr const_reference        at           (size_type              position) const
+  {
+    check_bounds(position);
+    return data()[position];
+  }
+  constexpr reference              at           (const multi_size_type& position)
+  {
+    check_bounds(position);
+    return span_(position);
+  }
+  constexpr const_reference        at           (const multi_size_type& position) const
+  {
+    check_bounds(position);
+    return span_(position);
+  }
+  template <typename... _positions>
+    requires (sizeof...(_positions) == _dimensions && _dimensions != 1)
+  constexpr reference              at           (_positions...          position)
+  {
+    return at(multi_size_type {static_cast<size_type>(position)...});
+  }
+  template <typename... _positions>
+    requires (sizeof...(_positions) == _dimensions && _dimensions != 1)
+  constexpr const_reference        at           (_positions...          position) const
+  {
+    return at(multi_size_type {static_cast<size_type>(position)...});
+  }
+
+  constexpr reference              operator[]   (size_type              position)
+  {
+    return data()[position];
+  }
+  constexpr const_reference        operator[]   (size_type              position) const
+  {
+    return data()[position];
+  }
+  constexpr reference              operator[]   (const multi_size_type& position)
+  {
+    return span_(position);
+  }
+  constexpr const_reference        operator[]   (const multi_size_type& position) const
+  {
+    return span_(position);
+  }
+
+  constexpr reference              operator()   (const multi_size_type& position)
+  {
+    return span_(position);
+  }
+  constexpr const_reference        operator()   (const multi_size_type& position) const
+  {
+    return span_(position);
+  }
+  template <typename... _positions>
+  constexpr reference              operator()   (_positions...          position)
+  {
+    return span_(position...);
+  }
+  template <typename... _positions>
+  constexpr const_reference        operator()   (_positions...          position) const
+  {
+    return span_(position...);
+  }
+
+  constexpr reference              front        ()
+  {
+    return data()[0];
+  }
+  constexpr const_reference        front        () const
+  {
+    return data()[0];
+  }
+  constexpr reference              back         ()
+  {
+    return data()[size() - 1];
+  }
+  constexpr const_reference        back         () const
+  {
+    return data()[size() - 1];
+  }
+
+  constexpr pointer                data         () noexcept
+  {
+    return storage_.get();
+  }
+  constexpr const_pointer          data         () const noexcept
+  {
+    return storage_.get();
+  }
+
+  // Iterators.
+
+  constexpr iterator               begin        () noexcept
+  {
+    return data();
+  }
+  constexpr const_iterator         begin        () const noexcept
+  {
+    return data();
+  }
+  constexpr const_iterator         cbegin       () const noexcept
+  {
+    return data();
+  }
+
+  constexpr iterator               end          () noexcept
+  {
+    return data() + size();
+  }
+  constexpr const_iterator         end          () const noexcept
+  {
+    return data() + size();
+  }
+  constexpr const_iterator         cend         () const noexcept
+  {
+    return data() + size();
+  }
+
+  constexpr reverse_iterator       rbegin       () noexcept
+  {
+    return reverse_iterator(end());
+  }
+  constexpr const_reverse_iterator rbegin       () const noexcept
+  {
+    return const_reverse_iterator(end());
+  }
+  constexpr reverse_iterator       rend         () noexcept
+  {
+    return reverse_iterator(begin());
+  }
+  constexpr const_reverse_iterator rend         () const noexcept
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  // Elements with their positions, in memory order.
+  constexpr indexed_type           indexed      () noexcept
+  {
+    return indexed_type(span_);
+  }
+  constexpr const_indexed_type     indexed      () const noexcept
+  {
+    return const_indexed_type(span_);
+  }
+
+  // Capacity.
+
+  constexpr bool                   empty        () const noexcept
+  {
+    return size() == 0;
+  }
+  constexpr size_type              size         () const noexcept
+  {
+    return span_.size();
+  }
+  constexpr multi_size_type        dimensions   () const noexcept
+  {
+    multi_size_type result;
+    for (size_type i = 0; i < _dimensions; ++i)
+      result[i] = span_.extent(i);
+    return result;
+  }
+
+  // Modifiers.
+
+  // Gives up ownership of the buffer, which the caller is then responsible for (e.g. through get_deleter()), and
+  // leaves the container empty.
+  [[nodiscard]]
+  constexpr pointer                release      () noexcept
+  {
+    span_ = {};
+    return storage_.release();
+  }
+  // Deletes the buffer and leaves the container empty.
+  constexpr void                   reset        () noexcept
+  {
+    storage_.reset();
+    span_ = {};
+  }
+
+  constexpr void                   swap         (adopted_vector& that) noexcept
+  {
+    std::swap(storage_, that.storage_);
+    std::swap(span_   , that.span_   );
+  }
+
+  // Member access.
+
+  constexpr deleter_type&          get_deleter  () noexcept
+  {
+    return storage_.get_deleter();
+  }
+  constexpr const deleter_type&    get_deleter  () const noexcept
+  {
+    return storage_.get_deleter();
+  }
+  constexpr const span_type&       span         () const noexcept
+  {
+    return span_;
+  }
+
+protected:
+  constexpr void                   check_bounds (size_type              position) const
+  {
+    if (position >= size())
+      throw std::out_of_range("multi::adopted_vector::at");
+  }
+  constexpr void                   check_bounds (const multi_size_type& position) const
+  {
+    for (size_type i = 0; i < _dimensions; ++i)
+      if (position[i] >= span_.extent(i))
+        throw std::out_of_range("multi::adopted_vector::at");
+  }
+
+  storage_type storage_;
+  span_type    span_   ;
+};
+
+// Non-member functions.
+
+template <typename _type, std::size_t _dimensions, typename _layout, typename _deleter>
+constexpr void swap(
+  adopted_vector<_type, _dimensions, _layout, _deleter>& lhs,
+  adopted_vector<_type, _dimensions, _layout, _deleter>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+}
@@ -0,0 +1,358 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <multi/execution.hpp>
+#include <multi/nested_for.hpp>
+#include <multi/simd.hpp>
+#include <multi/third_party/mdspan.hpp>
+#include <multi/vector.hpp>
+
+// Bulk operations over mdspans or containers (through their spans), running the SIMD kernels over contiguous runs of
+// elements: the whole storage of exhaustive spans with matching mappings, rows along a shared unit-stride axis
+// otherwise, and single elements as a last resort. Spans must use the default accessor and a strided layout.
+namespace multi
+{
+namespace detail
+{
+inline constexpr std::size_t equal_chunk_size = std::size_t(1) << 18; // Bytes.
+
+template <typename _container>
+constexpr auto span_of(const _container& container)
+{
+  if constexpr (requires { container.span(); })
+    return container.span();
+  else
+    return container;
+}
+
+// Targets are written through their spans, which containers hand out also when const. Const containers, whose data()
+// yields pointers to const, are therefore rejected, while spans and views are writable as their element type permits.
+template <typename _target>
+concept const_container = std::is_const_v<std::remove_reference_t<_target>> && requires (_target& target)
+{
+  requires std::is_const_v<std::remove_reference_t<decltype(*target.data())>>;
+};
+template <typename _target>
+concept writable_target = !const_container<_target>;
+
+template <typename _span>
+constexpr void check_span()
+{
+  static_assert(std::is_same_v<typename _span::accessor_type, std::experimental::default_accessor<typename _span::element_type>>, "The span must use the default accessor.");
+  static_assert(_span::mapping_type::is_always_strided(), "The span must have a strided layout.");
+}
+
+template <typename _span>
+constexpr std::size_t offset_of(const _span& span, const std::array<std::size_t, _span::rank()>& position)
+{
+  std::size_t result = 0;
+  for (std::size_t i = 0; i < _span::rank(); ++i)
+    result += position[i] * span.stride(i);
+  return result;
+}
+
+// Calls function(pointers..., length) for contiguous runs of corresponding elements of spans of equal extents.
+template <typename _function, typename _span, typename... _spans>
+void for_each_run(_function&& function, const _span& span, const _spans&... spans)
+{
+  check_span<_span>();
+  (check_span<_spans>(), ...);
+
+  constexpr auto rank = _span::rank();
+  std::array<std::size_t, rank> extents;
+  for (std::size_t i = 0; i < rank; ++i)
+    extents[i] = span.extent(i);
+  if (span.size() == 0)
+    return;
+
+  [[maybe_unused]] const auto same_strides = [&] (const auto& other)
+  {
+    for (std::size_t i = 0; i < rank; ++i)
+      if (extents[i] > 1 && static_cast<std::size_t>(other.stride(i)) != static_cast<std::size_t>(span.stride(i)))
+        return false;
+    return true;
+  };
+  if (span.is_contiguous() && ((spans.is_contiguous() && same_strides(spans)) && ...))
+  {
+    function(span.data(), spans.data()..., span.size());
+    return;
+  }
+
+  // Rows along an axis of unit stride in every span, or single elements.
+  auto axis = rank;
+  for (std::size_t i = rank; i-- > 0;)
+    if (span.stride(i) == 1 && ((spans.stride(i) == 1) && ...))
+    {
+      axis = i;
+      break;
+    }
+  const auto length = axis < rank ? extents[axis] : 1;
+  if (axis < rank)
+    extents[axis] = 1;
+  nested_for(extents, [&] (const std::array<std::size_t, rank>& position)
+  {
+    function(span.data() + offset_of(span, position), spans.data() + offset_of(spans, position)..., length);
+  });
+}
+
+template <typename _lhs, typename _rhs>
+void check_extents(const _lhs& lhs, const _rhs& rhs, const char* name)
+{
+  static_assert(_lhs::rank() == _rhs::rank(), "The spans must have the same rank.");
+  for (std::size_t i = 0; i < _lhs::rank(); ++i)
+    if (lhs.extent(i) != rhs.extent(i))
+      throw std::invalid_argument(name);
+}
+
+template <typename _span>
+concept strided_mapping = _span::mapping_type::is_always_strided();
+template <typename _span>
+concept strided_span    = strided_mapping<_span> && std::is_same_v<typename _span::accessor_type, std::experimental::default_accessor<typename _span::element_type>>;
+
+inline constexpr std::size_t copy_block_size    = 32;                    // Elements per axis.
+inline constexpr std::size_t parallel_copy_size = std::size_t(1) << 20; // Bytes.
+
+// The axis of the smallest stride, the last for layouts which are not strided and for lazy views.
+template <typename _span>
+constexpr std::size_t inner_axis(const _span& span)
+{
+  auto result = _span::rank() - 1;
+  if constexpr (strided_mapping<_span>)
+    for (std::size_t i = _span::rank() - 1; i-- > 0;)
+      if (span.extent(i) > 1 && (span.extent(result) <= 1 || span.stride(i) < span.stride(result)))
+        result = i;
+  return result;
+}
+
+// Copies [begin, end) along the axis from the position.
+template <typename _source, typename _target>
+void copy_row(const _source& source, const _target& target, std::array<std::size_t, _source::rank()> position, std::size_t axis, std::size_t end)
+{
+  if constexpr (strided_span<_source> && strided_span<_target>)
+  {
+    const auto input        = source.data() + offset_of(source, position);
+    const auto output       = target.data() + offset_of(target, position);
+    const auto length       = end - position[axis];
+    const auto input_stride = source.stride(axis), output_stride = target.stride(axis);
+    if (input_stride == 1 && output_stride == 1)
+      simd::copy(input, length, output);
+    else
+      for (std::size_t i = 0; i < length; ++i)
+        output[i * output_stride] = input[i * input_stride];
+  }
+  else
+    for (; position[axis] < end; ++position[axis])
+      target(position) = source(position);
+}
+
+// Copies rows along the inner axis of the target, within blocks over the inner axes of both spans if these differ.
+template <typename _source, typename _target, typename _execution_policy>
+void copy_blocks(const _source& source, const _target& target, _execution_policy&& policy)
+{
+  constexpr auto rank          = _source::rank();
+  const auto     source_axis   = inner_axis(source);
+  const auto     target_axis   = inner_axis(target);
+
+  std::array<std::size_t, rank> block, grid;
+  for (std::size_t i = 0; i < rank; ++i)
+  {
+    block[i] = i == target_axis ? (source_axis == target_axis ? target.extent(i) : copy_block_size) : i == source_axis ? copy_block_size : 1;
+    grid [i] = (target.extent(i) + block[i] - 1) / block[i];
+  }
+  std::size_t count = 1;
+  for (const auto extent : grid)
+    count *= extent;
+
+  for_each_index(policy, count, [&] (std::size_t index)
+  {
+    std::array<std::size_t, rank> begin, end;
+    for (auto i = rank; i-- > 0;)
+    {
+      begin[i] = index % grid[i] * block[i];
+      end  [i] = std::min(begin[i] + block[i], static_cast<std::size_t>(target.extent(i)));
+      index   /= grid[i];
+    }
+    // Rows of the target, stepping along the inner axis of the source.
+    for (auto position = begin; position[source_axis] < end[source_axis]; ++position[source_axis])
+    {
+      copy_row(source, target, position, target_axis, end[target_axis]);
+      if (source_axis == target_axis)
+        break;
+    }
+  });
+}
+}
+
+template <typename _target, typename _value>
+  requires detail::writable_target<_target>
+void fill   (_target&& target, const _value& value)
+{
+  using element_type = typename decltype(detail::span_of(target))::element_type;
+  detail::for_each_run([&] (element_type* data, std::size_t size)
+  {
+    simd::fill(data, size, static_cast<element_type>(value));
+  }, detail::span_of(target));
+}
+
+// Copies between spans of equal extents and any layouts. Spans with matching contiguous mappings are copied by
+// memcpy; otherwise rows along the innermost axis of the target are copied, within square blocks over the innermost
+// axes of both spans if these differ (e.g. between layout_left and layout_right), so that reads and writes stay within
+// cache. Chunks, rows or blocks are distributed by the policy once the volume is large enough.
+template <typename _source, typename _target, typename _execution_policy = const execution::sequenced_policy&>
+  requires detail::writable_target<_target>
+void copy   (const _source& source, _target&& target, _execution_policy&& policy = execution::seq)
+{
+  const auto source_span = detail::span_of(source);
+  const auto target_span = detail::span_of(target);
+  detail::check_extents(source_span, target_span, "multi::copy");
+
+  using source_span_type = decltype(source_span);
+  using target_span_type = decltype(target_span);
+  using element_type     = typename target_span_type::element_type;
+  const auto size     = target_span.size();
+  const auto parallel = size * sizeof(element_type) >= detail::parallel_copy_size;
+  if (size == 0)
+    return;
+
+  if constexpr (detail::strided_span<source_span_type> && detail::strided_span<target_span_type>)
+  {
+    auto same_mapping = source_span.is_contiguous() && target_span.is_contiguous();
+    for (std::size_t i = 0; i < target_span.rank(); ++i)
+      same_mapping = same_mapping && (target_span.extent(i) <= 1 || static_cast<std::size_t>(source_span.stride(i)) == static_cast<std::size_t>(target_span.stride(i)));
+    if (same_mapping)
+    {
+      const auto chunk_size = std::max<std::size_t>(detail::parallel_copy_size / sizeof(element_type), 1);
+      const auto chunk      = [&] (const std::size_t index)
+      {
+        const auto begin = index * chunk_size;
+        simd::copy(source_span.data() + begin, std::min(chunk_size, size - begin), target_span.data() + begin);
+      };
+      if (parallel)
+        for_each_index(policy       , (size + chunk_size - 1) / chunk_size, chunk);
+      else
+        for_each_index(execution::seq, (size + chunk_size - 1) / chunk_size, chunk);
+      return;
+    }
+  }
+
+  if (parallel)
+    detail::copy_blocks(source_span, target_span, policy);
+  else
+    detail::copy_blocks(source_span, target_span, execution::seq);
+}
+
+// Whether spans of equal extents have equal elements. Contiguous spans with matching mappings are compared in chunks
+// concurrently, which stop once a difference is found; others sequentially.
+template <typename _lhs, typename _rhs, typename _execution_policy = const execution::sequenced_policy&>
+bool equal  (const _lhs& lhs, const _rhs& rhs, _execution_policy&& policy = execution::seq)
+{
+  const auto lhs_span = detail::span_of(lhs);
+  const auto rhs_span = detail::span_of(rhs);
+  static_assert(decltype(lhs_span)::rank() == decltype(rhs_span)::rank(), "The spans must have the same rank.");
+  detail::check_span<decltype(lhs_span)>();
+  detail::check_span<decltype(rhs_span)>();
+  auto contiguous = lhs_span.is_contiguous() && rhs_span.is_contiguous();
+  for (std::size_t i = 0; i < lhs_span.rank(); ++i)
+  {
+    if (lhs_span.extent(i) != rhs_span.extent(i))
+      return false;
+    contiguous = contiguous && (lhs_span.extent(i) <= 1 || static_cast<std::size_t>(lhs_span.stride(i)) == static_cast<std::size_t>(rhs_span.stride(i)));
+  }
+
+  using element_type = typename decltype(lhs_span)::element_type;
+  if (contiguous && concurrency(policy) > 1)
+  {
+    const auto        size       = lhs_span.size();
+    const auto        chunk_size = std::max<std::size_t>(detail::equal_chunk_size / sizeof(element_type), 1);
+    std::atomic<bool> different  = false;
+    for_each_index(policy, (size + chunk_size - 1) / chunk_size, [&] (const std::size_t chunk)
+    {
+      if (different.load(std::memory_order_relaxed))
+        return;
+      const auto begin = chunk * chunk_size;
+      const auto end   = std::min(begin + chunk_size, size);
+      if (!simd::equal(lhs_span.data() + begin, rhs_span.data() + begin, end - begin))
+        different.store(true, std::memory_order_relaxed);
+    });
+    return !different.load();
+  }
+
+  auto result = true;
+  detail::for_each_run([&] (const element_type* left, const element_type* right, std::size_t size)
+  {
+    result = result && simd::equal(left, right, size);
+  }, lhs_span, rhs_span);
+  return result;
+}
+
+// The smallest and largest elements of a non-empty span.
+template <typename _source>
+auto minmax (const _source& source)
+{
+  using element_type = std::remove_const_t<typename decltype(detail::span_of(source))::element_type>;
+  std::pair<element_type, element_type> result;
+  auto                                  first = true;
+  detail::for_each_run([&] (const element_type* data, std::size_t size)
+  {
+    const auto [minimum, maximum] = simd::minmax(data, size);
+    result.first  = first || minimum < result.first  ? minimum : result.first ;
+    result.second = first || result.second < maximum ? maximum : result.second;
+    first         = false;
+  }, detail::span_of(source));
+  return result;
+}
+
+template <typename _target, typename _value>
+  requires detail::writable_target<_target>
+void clamp  (_target&& target, const _value& low, const _value& high)
+{
+  using element_type = typename decltype(detail::span_of(target))::element_type;
+  detail::for_each_run([&] (element_type* data, std::size_t size)
+  {
+    simd::clamp(data, size, static_cast<element_type>(low), static_cast<element_type>(high));
+  }, detail::span_of(target));
+}
+
+// Converts between spans of equal extents, saturating as simd::convert.
+template <typename _source, typename _target>
+  requires detail::writable_target<_target>
+void convert(const _source& source, _target&& target)
+{
+  const auto source_span = detail::span_of(source);
+  const auto target_span = detail::span_of(target);
+  detail::check_extents(source_span, target_span, "multi::convert");
+
+  using input_type  = typename decltype(source_span)::element_type;
+  using output_type = typename decltype(target_span)::element_type;
+  detail::for_each_run([&] (const input_type* input, output_type* output, std::size_t size)
+  {
+    simd::convert(input, size, output);
+  }, source_span, target_span);
+}
+// Returns a vector of the output type with the extents and layout of the source.
+template <typename _output, typename _type, std::size_t _dimensions, typename _layout, typename _accessor, typename _allocator, typename _extents>
+auto convert(const vector<_type, _dimensions, _layout, _accessor, _allocator, _extents>& source)
+{
+  using result_type = vector<_output, _dimensions, _layout, std::experimental::default_accessor<_output>, std::allocator<_output>, _extents>;
+
+  typename result_type::dynamic_size_type size {};
+  for (std::size_t i = 0, j = 0; i < _dimensions; ++i)
+    if (_extents::static_extent(i) == std::experimental::dynamic_extent)
+      size[j++] = source.dimensions()[i];
+
+  result_type result;
+  if constexpr (_dimensions == 1 && _extents::rank_dynamic() == 1)
+    result = result_type(size[0], _output());
+  else
+    result = result_type(size, _output());
+  convert(source, result);
+  return result;
+}
+}
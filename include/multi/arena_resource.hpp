@@ -0,0 +1,147 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace multi::pmr
+{
+// Bump-pointer memory resource for short-lived buffers. Unlike std::pmr::monotonic_buffer_resource, reset() keeps the
+// upstream memory (coalesced into a single chunk), so a warmed-up arena serves every later cycle without upstream calls.
+// Deallocation is a no-op except for the most recent allocation, which is rolled back. Not thread-safe.
+class arena_resource : public std::pmr::memory_resource
+{
+public:
+  static constexpr std::size_t default_chunk_size = std::size_t(1) << 22;
+  static constexpr std::size_t minimum_alignment  = 64;
+
+  explicit arena_resource(std::size_t initial_size = default_chunk_size, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+  : upstream_(upstream), next_chunk_size_(std::max(initial_size, minimum_alignment))
+  {
+
+  }
+  arena_resource(const arena_resource&  that) = delete;
+  arena_resource(      arena_resource&& temp) = delete;
+  ~arena_resource() override
+  {
+    release();
+  }
+
+  arena_resource& operator=(const arena_resource&  that) = delete;
+  arena_resource& operator=(      arena_resource&& temp) = delete;
+
+  // Invalidates all allocations. Memory is retained; multiple chunks are replaced by one covering their total size.
+  void                        reset   ()
+  {
+    if (chunks_.size() > 1)
+    {
+      const auto total = capacity();
+      release();
+      next_chunk_size_ = total;
+      allocate_chunk(total);
+    }
+    current_ = 0;
+    offset_  = 0;
+    size_    = 0;
+  }
+  // Invalidates all allocations and returns the memory to the upstream resource.
+  void                        release () noexcept
+  {
+    for (const auto& chunk : chunks_)
+      upstream_->deallocate(chunk.data, chunk.size, minimum_alignment);
+    chunks_.clear();
+    current_ = 0;
+    offset_  = 0;
+    size_    = 0;
+  }
+
+  std::size_t                 size    () const noexcept
+  {
+    return size_;
+  }
+  std::size_t                 capacity() const noexcept
+  {
+    std::size_t result = 0;
+    for (const auto& chunk : chunks_)
+      result += chunk.size;
+    return result;
+  }
+  std::size_t                 chunk_count() const noexcept
+  {
+    return chunks_.size();
+  }
+  std::pmr::memory_resource*  upstream_resource() const noexcept
+  {
+    return upstream_;
+  }
+
+protected:
+  struct chunk
+  {
+    std::byte*  data;
+    std::size_t size;
+  };
+
+  static constexpr std::size_t align_up(std::size_t value, std::size_t alignment) noexcept
+  {
+    return (value + alignment - 1) & ~(alignment - 1);
+  }
+
+  void*                       do_allocate  (std::size_t bytes, std::size_t alignment) override
+  {
+    alignment = std::max(alignment, minimum_alignment);
+
+    for (; current_ < chunks_.size(); ++current_, offset_ = 0)
+    {
+      const auto begin = aligned_offset(alignment);
+      if (begin + bytes <= chunks_[current_].size)
+        return commit(begin, bytes);
+    }
+
+    allocate_chunk(bytes + alignment - minimum_alignment);
+    return commit(aligned_offset(alignment), bytes);
+  }
+  void                        do_deallocate(void* pointer, std::size_t bytes, std::size_t /* alignment */) override
+  {
+    if (current_ < chunks_.size() && static_cast<std::byte*>(pointer) + bytes == chunks_[current_].data + offset_)
+    {
+      offset_ = static_cast<std::size_t>(static_cast<std::byte*>(pointer) - chunks_[current_].data);
+      size_  -= bytes;
+    }
+  }
+  bool                        do_is_equal  (const std::pmr::memory_resource& that) const noexcept override
+  {
+    return this == &that;
+  }
+
+  std::size_t                 aligned_offset(std::size_t alignment) const noexcept
+  {
+    const auto address = reinterpret_cast<std::uintptr_t>(chunks_[current_].data);
+    return align_up(address + offset_, alignment) - address;
+  }
+  void*                       commit       (std::size_t begin, std::size_t bytes) noexcept
+  {
+    offset_  = begin + bytes;
+    size_   += bytes;
+    return chunks_[current_].data + begin;
+  }
+  void                        allocate_chunk(std::size_t minimum_size)
+  {
+    const auto size = align_up(std::max(minimum_size, next_chunk_size_), minimum_alignment);
+    chunks_.reserve(chunks_.size() + 1);
+    chunks_.push_back(chunk {static_cast<std::byte*>(upstream_->allocate(size, minimum_alignment)), size});
+    current_         = chunks_.size() - 1;
+    offset_          = 0;
+    next_chunk_size_ = size * 2;
+  }
+
+  std::pmr::memory_resource* upstream_        ;
+  std::vector<chunk>         chunks_          ;
+  std::size_t                current_         = 0;
+  std::size_t                offset_          = 0;
+  std::size_t                size_            = 0;
+  std::size_t                next_chunk_size_ ;
+};
+}
@@ -1,10 +1,15 @@
 #pragma once
 
 #include <array>
+#include <compare>
 #include <cstddef>
+#include <type_traits>
 #include <utility>
 
+#include <multi/ndindex.hpp>
+#include <multi/simd.hpp>
 #include <multi/third_party/mdspan.hpp>
+#include <multi/traits.hpp>
 
 namespace multi
 {
@@ -46,6 +51,12 @@ public:
   using const_iterator         = typename storage_type::const_iterator;
   using reverse_iterator       = typename storage_type::reverse_iterator;
   using const_reverse_iterator = typename storage_type::const_reverse_iterator;
+
+  using accessor_type          = _accessor;
+  using span_reference         = typename span_type::reference;
+  using span_const_reference   = const_reference_of_t<span_reference>;
+  using indexed_type           = indexed_range<span_type>;
+  using const_indexed_type     = indexed_range<span_type, span_const_reference>;
   
   using multi_size_type        = std::array<size_type, span_type::rank()>;
 
@@ -116,21 +127,21 @@ public:
   {
     return storage_.at(position);
   }
-  constexpr reference              at           (const multi_size_type& position)
+  constexpr span_reference         at           (const multi_size_type& position)
   {
     return span_(position);
   }
-  constexpr const_reference        at           (const multi_size_type& position) const
+  constexpr span_const_reference   at           (const multi_size_type& position) const
   {
     return span_(position);
   }
   template <typename... _positions>
-  constexpr reference              at           (_positions...          position)
+  constexpr span_reference         at           (_positions...          position)
   {
     return span_(position...);
   }
   template <typename... _positions>
-  constexpr const_reference        at           (_positions...          position) const
+  constexpr span_const_reference   at           (_positions...          position) const
   {
     return span_(position...);
   }
@@ -143,30 +154,30 @@ public:
   {
     return storage_[position];
   }
-  constexpr reference              operator[]   (const multi_size_type& position)
+  constexpr span_reference         operator[]   (const multi_size_type& position)
   {
     return span_(position);
   }
-  constexpr const_reference        operator[]   (const multi_size_type& position) const
+  constexpr span_const_reference   operator[]   (const multi_size_type& position) const
   {
     return span_(position);
   }
   
-  constexpr reference              operator()   (const multi_size_type& position)
+  constexpr span_reference         operator()   (const multi_size_type& position)
   {
     return span_(position);
   }
-  constexpr const_reference        operator()   (const multi_size_type& position) const
+  constexpr span_const_reference   operator()   (const multi_size_type& position) const
   {
     return span_(position);
   }
   template <typename... _positions>
-  constexpr reference              operator()   (_positions...          position)
+  constexpr span_reference         operator()   (_positions...          position)
   {
     return span_(position...);
   }
   template <typename... _positions>
-  constexpr const_reference        operator()   (_positions...          position) const
+  constexpr span_const_reference   operator()   (_positions...          position) const
   {
     return span_(position...);
   }
@@ -251,6 +262,16 @@ public:
   {
     return storage_.crend  ();
   }
+
+  // Elements with their positions, in memory order. Increments avoid divisions.
+  constexpr indexed_type           indexed      () noexcept
+  {
+    return indexed_type      (span_);
+  }
+  constexpr const_indexed_type     indexed      () const noexcept
+  {
+    return const_indexed_type(span_);
+  }
   
   // Capacity.
 
@@ -275,6 +296,12 @@ public:
   
   constexpr void                   fill         (const_reference value) noexcept
   {
+    if constexpr (simd::detail::vectorizable<_type>)
+      if (!std::is_constant_evaluated())
+      {
+        simd::fill(storage_.data(), storage_.size(), value);
+        return;
+      }
     storage_.fill(value);
   }
   constexpr void                   swap         (array& that) noexcept
@@ -315,13 +342,25 @@ constexpr bool operator== (
   const array<_type, _dimensions, _layout, _accessor>& lhs, 
   const array<_type, _dimensions, _layout, _accessor>& rhs)
 {
-  return lhs.storage() == rhs.storage() && lhs.span().mapping() == rhs.span().mapping();
+  if (!(lhs.span().mapping() == rhs.span().mapping()))
+    return false;
+  if constexpr (simd::detail::vectorizable<_type>)
+    if (!std::is_constant_evaluated())
+      return simd::equal(lhs.data(), rhs.data(), lhs.size());
+  return lhs.storage() == rhs.storage();
 }
 template <typename _type, typename _dimensions, typename _layout, typename _accessor>
 constexpr auto operator<=>(
   const array<_type, _dimensions, _layout, _accessor>& lhs, 
   const array<_type, _dimensions, _layout, _accessor>& rhs)
 {
+  if constexpr (simd::detail::vectorizable<_type>)
+    if (!std::is_constant_evaluated())
+    {
+      using ordering = decltype(lhs.storage() <=> rhs.storage());
+      const auto index = simd::mismatch(lhs.data(), rhs.data(), lhs.size());
+      return index < lhs.size() ? ordering(lhs.data()[index] <=> rhs.data()[index]) : ordering(std::strong_ordering::equal);
+    }
   return lhs.storage() <=> rhs.storage();
 }
 
@@ -371,4 +410,4 @@ struct tuple_element<_index, array<_type, _dimensions, _layout, _accessor>>
 {
   using type = _type;
 };
-}
\ No newline at end of file
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <multi/execution.hpp>
+#include <multi/nested_for.hpp>
+#include <multi/sparse_vector.hpp>
+#include <multi/vector.hpp>
+
+namespace multi
+{
+// Proxy performing every operation atomically through std::atomic_ref with the given memory order. Compound
+// assignments return the new value, as for std::atomic_ref.
+template <typename _type, std::memory_order _order = std::memory_order_relaxed>
+class atomic_reference
+{
+public:
+  using value_type = _type;
+
+  constexpr explicit atomic_reference(value_type& value) noexcept
+  : reference_(value)
+  {
+
+  }
+  constexpr atomic_reference(const atomic_reference& that) noexcept = default;
+
+  atomic_reference& operator= (const value_type& value) noexcept
+  {
+    store(value);
+    return *this;
+  }
+  atomic_reference& operator= (const atomic_reference& that) noexcept
+  {
+    store(that.load());
+    return *this;
+  }
+  value_type        operator+=(const value_type& value) noexcept
+  {
+    return fetch_add(value) + value;
+  }
+  value_type        operator-=(const value_type& value) noexcept
+  {
+    return fetch_sub(value) - value;
+  }
+  operator value_type() const noexcept
+  {
+    return load();
+  }
+
+  value_type        load     () const noexcept
+  {
+    return reference_.load(load_order);
+  }
+  void              store    (const value_type& value) const noexcept
+  {
+    reference_.store(value, store_order);
+  }
+  value_type        exchange (const value_type& value) const noexcept
+  {
+    return reference_.exchange(value, _order);
+  }
+  value_type        fetch_add(const value_type& value) const noexcept
+  {
+    return reference_.fetch_add(value, _order);
+  }
+  value_type        fetch_sub(const value_type& value) const noexcept
+  {
+    return reference_.fetch_sub(value, _order);
+  }
+
+protected:
+  // Loads and stores use the strongest valid order not exceeding _order.
+  static constexpr std::memory_order load_order  =
+    _order == std::memory_order_release ? std::memory_order_relaxed :
+    _order == std::memory_order_acq_rel ? std::memory_order_acquire : _order;
+  static constexpr std::memory_order store_order =
+    _order == std::memory_order_acquire || _order == std::memory_order_consume ? std::memory_order_relaxed :
+    _order == std::memory_order_acq_rel ? std::memory_order_release : _order;
+
+  std::atomic_ref<value_type> reference_;
+};
+
+// Accessor making concurrent element access through the container's span race-free. Relaxed by default, which suits
+// accumulation (histogramming, splatting) where only the final values are observed after joining.
+template <typename _type, std::memory_order _order = std::memory_order_relaxed>
+struct atomic_accessor
+{
+  using offset_policy = atomic_accessor;
+  using element_type  = _type;
+  using reference     = atomic_reference<_type, _order>;
+  using pointer       = _type*;
+
+  static_assert(alignof(_type) >= std::atomic_ref<_type>::required_alignment, "The element type is not sufficiently aligned for std::atomic_ref.");
+
+  constexpr pointer   offset(pointer p, std::size_t i) const noexcept
+  {
+    return p + i;
+  }
+  constexpr reference access(pointer p, std::size_t i) const noexcept
+  {
+    return reference(p[i]);
+  }
+};
+
+// Calls function(i, add) for each i in [0, count), where add(position, value) accumulates value at the position of the
+// target. Each thread accumulates into private copies of only the _tile_size^N tiles it touches; the copies are then
+// merged into the target concurrently, one tile per task, so the target needs no atomic accessor.
+template <std::size_t _tile_size = 8, typename _type, std::size_t _dimensions, typename _layout, typename _accessor, typename _allocator, typename _function, typename _execution_policy = const execution::sequenced_policy&>
+void scatter_add(vector<_type, _dimensions, _layout, _accessor, _allocator>& target, std::size_t count, _function&& function, _execution_policy&& policy = execution::seq)
+{
+  using tiles_type      = sparse_vector<_type, _dimensions, _tile_size>;
+  using multi_size_type = typename tiles_type::multi_size_type;
+
+  const auto dimensions = target.dimensions();
+  const auto partitions = std::max<std::size_t>(std::min(concurrency(policy), count), 1);
+
+  std::vector<tiles_type> copies(partitions, tiles_type(dimensions, _type()));
+  for_each_index(policy, partitions, [&] (const std::size_t partition)
+  {
+    auto&      copy  = copies[partition];
+    const auto range = partition_range(count, partitions, partition);
+    const auto add   = [&copy] (const multi_size_type& position, const _type& value)
+    {
+      copy(position) += value;
+    };
+    for (auto i = range.first; i < range.second; ++i)
+      function(i, add);
+  });
+
+  std::unordered_map<multi_size_type, std::vector<const typename tiles_type::block_type*>, detail::multi_size_hash<multi_size_type>> tiles;
+  for (const auto& copy : copies)
+    copy.for_each_block([&] (const multi_size_type& position, const typename tiles_type::block_type& tile)
+    {
+      tiles[position].push_back(&tile);
+    });
+  const std::vector<std::pair<multi_size_type, std::vector<const typename tiles_type::block_type*>>> merges(tiles.begin(), tiles.end());
+
+  for_each_index(policy, merges.size(), [&] (const std::size_t index)
+  {
+    const auto& [tile_position, sources] = merges[index];
+
+    // The tile, clipped to the target.
+    multi_size_type begin, end;
+    for (std::size_t d = 0; d < _dimensions; ++d)
+    {
+      begin[d] = tile_position[d] * _tile_size;
+      end  [d] = std::min(begin[d] + _tile_size, dimensions[d]);
+    }
+    nested_for(begin, end, [&] (const multi_size_type& position)
+    {
+      // Local index in the layout_right order of the tile storage.
+      std::size_t i = 0;
+      for (std::size_t d = 0; d < _dimensions; ++d)
+        i = i * _tile_size + position[d] - begin[d];
+
+      auto sum = (*sources.front())[i];
+      for (auto source = sources.begin() + 1; source != sources.end(); ++source)
+        sum += (**source)[i];
+      target(position) += sum;
+    });
+  });
+}
+}
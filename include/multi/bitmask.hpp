@@ -0,0 +1,507 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <multi/execution.hpp>
+#include <multi/nested_for.hpp>
+#include <multi/third_party/mdspan.hpp>
+
+namespace multi
+{
+class bit_reference
+{
+public:
+  using value_type = bool;
+  using word_type  = std::uint64_t;
+
+  constexpr bit_reference(word_type* word, word_type mask) noexcept
+  : word_(word), mask_(mask)
+  {
+
+  }
+  constexpr bit_reference(const bit_reference&  that) noexcept = default;
+
+  constexpr bit_reference& operator=(bool value) noexcept
+  {
+    if (value)
+      *word_ |=  mask_;
+    else
+      *word_ &= ~mask_;
+    return *this;
+  }
+  constexpr bit_reference& operator=(const bit_reference& that) noexcept
+  {
+    return operator=(static_cast<bool>(that));
+  }
+  constexpr                operator bool() const noexcept
+  {
+    return (*word_ & mask_) != 0;
+  }
+  constexpr bool           operator~    () const noexcept
+  {
+    return (*word_ & mask_) == 0;
+  }
+  constexpr bit_reference& flip         () noexcept
+  {
+    *word_ ^= mask_;
+    return *this;
+  }
+
+protected:
+  word_type* word_;
+  word_type  mask_;
+};
+
+// Accessor over bit indices into an array of words. Offsets must be multiples of the word size.
+struct bit_accessor
+{
+  using offset_policy = bit_accessor;
+  using element_type  = bool;
+  using reference     = bit_reference;
+  using pointer       = bit_reference::word_type*;
+
+  static constexpr std::size_t word_bits = std::numeric_limits<bit_reference::word_type>::digits;
+
+  constexpr pointer   offset(pointer p, std::size_t i) const noexcept
+  {
+    return p + i / word_bits;
+  }
+  constexpr reference access(pointer p, std::size_t i) const noexcept
+  {
+    return reference(p + i / word_bits, bit_reference::word_type(1) << (i % word_bits));
+  }
+};
+
+// Bit-packed boolean hyper-rectangular storage. Rows (the last dimension) start at word boundaries and padding bits are
+// kept zero, so that bulk operations, counting and morphology process a word of elements at a time.
+template <std::size_t _dimensions>
+class bitmask
+{
+public:
+  using word_type              = bit_reference::word_type;
+  using storage_type           = std::vector<word_type>;
+  using span_type              = std::experimental::mdspan<bool, std::experimental::dextents<_dimensions>, std::experimental::layout_stride, bit_accessor>;
+
+  using value_type             = bool;
+  using size_type              = std::size_t;
+  using difference_type        = std::ptrdiff_t;
+  using reference              = bit_reference;
+  using const_reference        = bool;
+  using pointer                = word_type*;
+  using const_pointer          = const word_type*;
+
+  using multi_size_type        = std::array<size_type, _dimensions>;
+
+  static constexpr size_type word_bits = bit_accessor::word_bits;
+
+  constexpr          bitmask() = default;
+  constexpr explicit bitmask(const multi_size_type& size, bool value = false)
+  : dimensions_(size), storage_(row_count(size) * row_words(size), value ? ~word_type(0) : word_type(0))
+  {
+    update_span();
+    if (value)
+      clear_padding();
+  }
+
+  constexpr          bitmask(const bitmask&  that)
+  : dimensions_(that.dimensions_), storage_(that.storage_)
+  {
+    update_span();
+  }
+  constexpr          bitmask(      bitmask&& temp) noexcept
+  : dimensions_(std::exchange(temp.dimensions_, {})), storage_(std::move(temp.storage_))
+  {
+    update_span();
+    temp.storage_ = {};
+    temp.span_    = {};
+  }
+
+  constexpr         ~bitmask() = default;
+
+  constexpr bitmask&               operator=    (const bitmask&  that)
+  {
+    if (this != &that)
+    {
+      dimensions_ = that.dimensions_;
+      storage_    = that.storage_;
+      update_span();
+    }
+    return *this;
+  }
+  constexpr bitmask&               operator=    (      bitmask&& temp) noexcept
+  {
+    if (this != &temp)
+    {
+      dimensions_   = std::exchange(temp.dimensions_, {});
+      storage_      = std::move(temp.storage_);
+      update_span();
+
+      temp.storage_ = {};
+      temp.span_    = {};
+    }
+    return *this;
+  }
+
+  // Element access.
+
+  constexpr reference              at           (const multi_size_type& position)
+  {
+    check_bounds(position);
+    return span_(position);
+  }
+  constexpr const_reference        at           (const multi_size_type& position) const
+  {
+    check_bounds(position);
+    return span_(position);
+  }
+  template <typename... _positions>
+  constexpr reference              at           (_positions...          position)
+  {
+    return at(multi_size_type {static_cast<size_type>(position)...});
+  }
+  template <typename... _positions>
+  constexpr const_reference        at           (_positions...          position) const
+  {
+    return at(multi_size_type {static_cast<size_type>(position)...});
+  }
+
+  constexpr reference              operator[]   (const multi_size_type& position)
+  {
+    return span_(position);
+  }
+  constexpr const_reference        operator[]   (const multi_size_type& position) const
+  {
+    return span_(position);
+  }
+
+  constexpr reference              operator()   (const multi_size_type& position)
+  {
+    return span_(position);
+  }
+  constexpr const_reference        operator()   (const multi_size_type& position) const
+  {
+    return span_(position);
+  }
+  template <typename... _positions>
+  constexpr reference              operator()   (_positions...          position)
+  {
+    return span_(position...);
+  }
+  template <typename... _positions>
+  constexpr const_reference        operator()   (_positions...          position) const
+  {
+    return span_(position...);
+  }
+
+  constexpr pointer                data         () noexcept
+  {
+    return storage_.data();
+  }
+  constexpr const_pointer          data         () const noexcept
+  {
+    return storage_.data();
+  }
+
+  // Capacity.
+
+  constexpr bool                   empty        () const noexcept
+  {
+    return size() == 0;
+  }
+  constexpr size_type              size         () const noexcept
+  {
+    return std::accumulate(dimensions_.begin(), dimensions_.end(), static_cast<size_type>(1), std::multiplies<size_type>());
+  }
+  constexpr multi_size_type        dimensions   () const noexcept
+  {
+    return dimensions_;
+  }
+  constexpr size_type              row_count    () const noexcept
+  {
+    return row_count(dimensions_);
+  }
+  constexpr size_type              row_words    () const noexcept
+  {
+    return row_words(dimensions_);
+  }
+
+  // Bit operations.
+
+  constexpr size_type              count        () const noexcept
+  {
+    size_type result = 0;
+    for (const auto& word : storage_)
+      result += static_cast<size_type>(std::popcount(word));
+    return result;
+  }
+  constexpr bool                   any          () const noexcept
+  {
+    return std::any_of(storage_.begin(), storage_.end(), [ ] (const word_type word) { return word != 0; });
+  }
+  constexpr bool                   none         () const noexcept
+  {
+    return !any();
+  }
+  constexpr bool                   all          () const noexcept
+  {
+    return count() == size();
+  }
+
+  constexpr bitmask&               set          () noexcept
+  {
+    std::fill(storage_.begin(), storage_.end(), ~word_type(0));
+    clear_padding();
+    return *this;
+  }
+  constexpr bitmask&               reset        () noexcept
+  {
+    std::fill(storage_.begin(), storage_.end(), word_type(0));
+    return *this;
+  }
+  constexpr bitmask&               flip         () noexcept
+  {
+    for (auto& word : storage_)
+      word = ~word;
+    clear_padding();
+    return *this;
+  }
+
+  // Operands must have identical dimensions.
+  constexpr bitmask&               operator&=   (const bitmask& that) noexcept
+  {
+    for (size_type i = 0; i < storage_.size(); ++i)
+      storage_[i] &= that.storage_[i];
+    return *this;
+  }
+  constexpr bitmask&               operator|=   (const bitmask& that) noexcept
+  {
+    for (size_type i = 0; i < storage_.size(); ++i)
+      storage_[i] |= that.storage_[i];
+    return *this;
+  }
+  constexpr bitmask&               operator^=   (const bitmask& that) noexcept
+  {
+    for (size_type i = 0; i < storage_.size(); ++i)
+      storage_[i] ^= that.storage_[i];
+    return *this;
+  }
+  constexpr bitmask                operator~    () const
+  {
+    return bitmask(*this).flip();
+  }
+
+  // Calls function(position) for each set element, in storage order.
+  template <typename _function>
+  constexpr void                   for_each_set (_function&& function) const
+  {
+    // Rows are visited by nesting over all but the last axis.
+    const auto words = row_words();
+    auto       rows  = dimensions_;
+    rows.back()      = 1;
+    size_type  row   = 0;
+    nested_for(rows, [&] (const multi_size_type& row_start)
+    {
+      auto position = row_start;
+      for (size_type i = 0; i < words; ++i)
+        for (auto word = storage_[row * words + i]; word != 0; word &= word - 1)
+        {
+          position.back() = i * word_bits + static_cast<size_type>(std::countr_zero(word));
+          function(static_cast<const multi_size_type&>(position));
+        }
+      ++row;
+    });
+  }
+  constexpr std::optional<multi_size_type> find_first() const noexcept
+  {
+    const auto words = row_words();
+    for (size_type i = 0; i < storage_.size(); ++i)
+      if (storage_[i] != 0)
+      {
+        auto position = row_position(i / words);
+        position.back() = (i % words) * word_bits + static_cast<size_type>(std::countr_zero(storage_[i]));
+        return position;
+      }
+    return std::nullopt;
+  }
+
+  // Morphology with the diamond-shaped structuring element of the given radius, i.e. the elements within that L1
+  // (Manhattan) distance, as radius iterations of the face-connected cross of radius 1. Elements outside the bitmask
+  // are treated as unset.
+  template <typename _execution_policy = const execution::sequenced_policy&>
+  bitmask&                         dilate       (size_type radius = 1, _execution_policy&& policy = execution::seq)
+  {
+    for (size_type i = 0; i < radius; ++i)
+      morph<false>(policy);
+    return *this;
+  }
+  template <typename _execution_policy = const execution::sequenced_policy&>
+  bitmask&                         erode        (size_type radius = 1, _execution_policy&& policy = execution::seq)
+  {
+    for (size_type i = 0; i < radius; ++i)
+      morph<true >(policy);
+    return *this;
+  }
+
+  // Operations.
+
+  constexpr void                   swap         (bitmask& that) noexcept
+  {
+    std::swap(dimensions_, that.dimensions_);
+    std::swap(storage_   , that.storage_   );
+    std::swap(span_      , that.span_      );
+  }
+
+  // Member access.
+
+  constexpr const storage_type&    storage      () const noexcept
+  {
+    return storage_;
+  }
+  constexpr const span_type&       span         () const noexcept
+  {
+    return span_;
+  }
+
+protected:
+  static constexpr size_type       row_count    (const multi_size_type& size) noexcept
+  {
+    return std::accumulate(size.begin(), size.end() - 1, static_cast<size_type>(1), std::multiplies<size_type>());
+  }
+  static constexpr size_type       row_words    (const multi_size_type& size) noexcept
+  {
+    return (size.back() + word_bits - 1) / word_bits;
+  }
+
+  constexpr multi_size_type        row_position (size_type row) const noexcept
+  {
+    multi_size_type result {};
+    for (size_type i = _dimensions - 1; i-- > 0;)
+    {
+      result[i] = row % dimensions_[i];
+      row      /= dimensions_[i];
+    }
+    return result;
+  }
+  constexpr void                   check_bounds (const multi_size_type& position) const
+  {
+    for (size_type i = 0; i < _dimensions; ++i)
+      if (position[i] >= dimensions_[i])
+        throw std::out_of_range("multi::bitmask::at");
+  }
+  constexpr void                   update_span  () noexcept
+  {
+    std::array<size_type, _dimensions> strides;
+    strides.back() = 1;
+    if constexpr (_dimensions > 1)
+    {
+      strides[_dimensions - 2] = row_words() * word_bits;
+      for (size_type i = _dimensions - 2; i-- > 0;)
+        strides[i] = strides[i + 1] * dimensions_[i + 1];
+    }
+    span_ = span_type(storage_.data(), typename span_type::mapping_type(typename span_type::extents_type(dimensions_), strides));
+  }
+  constexpr void                   clear_padding() noexcept
+  {
+    const auto remainder = dimensions_.back() % word_bits;
+    if (remainder == 0)
+      return;
+
+    const auto words = row_words();
+    const auto mask  = (word_type(1) << remainder) - 1;
+    for (size_type row = 0; row < row_count(); ++row)
+      storage_[row * words + words - 1] &= mask;
+  }
+
+  template <bool _erode, typename _execution_policy>
+  void                             morph        (_execution_policy&& policy)
+  {
+    const auto words  = row_words();
+    const auto source = storage_;
+    const auto row_at = [&] (const size_type row) { return source.data() + row * words; };
+
+    // Row strides and extents of the outer dimensions.
+    std::array<size_type, _dimensions> strides {};
+    if constexpr (_dimensions > 1)
+    {
+      strides[_dimensions - 2] = 1;
+      for (size_type i = _dimensions - 2; i-- > 0;)
+        strides[i] = strides[i + 1] * dimensions_[i + 1];
+    }
+
+    for_each_index(policy, row_count(), [&] (const size_type row)
+    {
+      const auto input  = row_at(row);
+      const auto output = storage_.data() + row * words;
+      for (size_type i = 0; i < words; ++i)
+      {
+        const auto lower = (input[i] << 1) | (i > 0         ? input[i - 1] >> (word_bits - 1) : 0);
+        const auto upper = (input[i] >> 1) | (i + 1 < words ? input[i + 1] << (word_bits - 1) : 0);
+        if constexpr (_erode)
+          output[i] = input[i] & lower & upper;
+        else
+          output[i] = input[i] | lower | upper;
+      }
+
+      for (size_type axis = 0; axis + 1 < _dimensions; ++axis)
+      {
+        const auto coordinate = (row / strides[axis]) % dimensions_[axis];
+        const auto previous   = coordinate > 0                    ? row_at(row - strides[axis]) : nullptr;
+        const auto next       = coordinate + 1 < dimensions_[axis] ? row_at(row + strides[axis]) : nullptr;
+        for (size_type i = 0; i < words; ++i)
+        {
+          if constexpr (_erode)
+            output[i] &= (previous ? previous[i] : 0) & (next ? next[i] : 0);
+          else
+            output[i] |= (previous ? previous[i] : 0) | (next ? next[i] : 0);
+        }
+      }
+    });
+    clear_padding();
+  }
+
+  multi_size_type dimensions_ {};
+  storage_type    storage_    ;
+  span_type       span_       ;
+};
+
+// Non-member functions.
+
+template <std::size_t _dimensions>
+constexpr bool operator== (const bitmask<_dimensions>& lhs, const bitmask<_dimensions>& rhs)
+{
+  return lhs.dimensions() == rhs.dimensions() && lhs.storage() == rhs.storage();
+}
+
+template <std::size_t _dimensions>
+constexpr bitmask<_dimensions> operator& (const bitmask<_dimensions>& lhs, const bitmask<_dimensions>& rhs)
+{
+  return bitmask<_dimensions>(lhs) &= rhs;
+}
+template <std::size_t _dimensions>
+constexpr bitmask<_dimensions> operator| (const bitmask<_dimensions>& lhs, const bitmask<_dimensions>& rhs)
+{
+  return bitmask<_dimensions>(lhs) |= rhs;
+}
+template <std::size_t _dimensions>
+constexpr bitmask<_dimensions> operator^ (const bitmask<_dimensions>& lhs, const bitmask<_dimensions>& rhs)
+{
+  return bitmask<_dimensions>(lhs) ^= rhs;
+}
+
+template <std::size_t _dimensions>
+constexpr void swap(bitmask<_dimensions>& lhs, bitmask<_dimensions>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+}
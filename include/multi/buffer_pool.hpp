@@ -0,0 +1,252 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <multi/vector.hpp>
+
+namespace multi
+{
+// Thread-safe recycler of vectors. Free lists are sharded by thread id and keyed by power-of-two linear size class, so
+// steady-state acquisitions reuse storage which is already allocated and touched. The pool must outlive its handles.
+template <
+  typename    _type      ,
+  std::size_t _dimensions,
+  typename    _layout    = std::experimental::layout_right,
+  typename    _allocator = std::allocator<_type>>
+class buffer_pool
+{
+public:
+  using vector_type     = vector<_type, _dimensions, _layout, std::experimental::default_accessor<_type>, _allocator>;
+  using value_type      = typename vector_type::value_type;
+  using allocator_type  = typename vector_type::allocator_type;
+  using size_type       = typename vector_type::size_type;
+  using multi_size_type = typename vector_type::multi_size_type;
+
+  static constexpr size_type size_class_count = std::numeric_limits<size_type>::digits;
+
+  // Owns an acquired vector and returns it to the pool on destruction.
+  class handle
+  {
+  public:
+    constexpr          handle() noexcept = default;
+    constexpr          handle(const handle&  that) = delete;
+    constexpr          handle(      handle&& temp) noexcept
+    : pool_(std::exchange(temp.pool_, nullptr)), vector_(std::move(temp.vector_))
+    {
+
+    }
+             ~handle()
+    {
+      reset();
+    }
+
+    constexpr handle&            operator=  (const handle&  that) = delete;
+    handle&                      operator=  (      handle&& temp) noexcept
+    {
+      if (this != &temp)
+      {
+        reset();
+        pool_   = std::exchange(temp.pool_, nullptr);
+        vector_ = std::move(temp.vector_);
+      }
+      return *this;
+    }
+
+    constexpr vector_type&       operator*  () noexcept
+    {
+      return vector_;
+    }
+    constexpr const vector_type& operator*  () const noexcept
+    {
+      return vector_;
+    }
+    constexpr vector_type*       operator-> () noexcept
+    {
+      return &vector_;
+    }
+    constexpr const vector_type* operator-> () const noexcept
+    {
+      return &vector_;
+    }
+    constexpr vector_type&       get        () noexcept
+    {
+      return vector_;
+    }
+    constexpr const vector_type& get        () const noexcept
+    {
+      return vector_;
+    }
+    constexpr explicit           operator bool() const noexcept
+    {
+      return pool_ != nullptr;
+    }
+
+    // Detaches the vector from the pool.
+    constexpr vector_type        release    () noexcept
+    {
+      pool_ = nullptr;
+      return std::move(vector_);
+    }
+    void                         reset      () noexcept
+    {
+      if (pool_)
+        std::exchange(pool_, nullptr)->recycle(std::move(vector_));
+    }
+
+  protected:
+    friend class buffer_pool;
+
+    constexpr handle(buffer_pool* pool, vector_type&& vector) noexcept
+    : pool_(pool), vector_(std::move(vector))
+    {
+
+    }
+
+    buffer_pool* pool_   = nullptr;
+    vector_type  vector_ ;
+  };
+
+  explicit buffer_pool(const allocator_type& alloc = allocator_type(), size_type shard_count = std::thread::hardware_concurrency())
+  : allocator_(alloc), shard_count_(std::max<size_type>(shard_count, 1)), shards_(std::make_unique<shard[]>(shard_count_))
+  {
+
+  }
+  buffer_pool(const buffer_pool&  that) = delete;
+  buffer_pool(      buffer_pool&& temp) = delete;
+  ~buffer_pool() = default;
+
+  buffer_pool&                     operator=    (const buffer_pool&  that) = delete;
+  buffer_pool&                     operator=    (      buffer_pool&& temp) = delete;
+
+  // The contents of a recycled vector are unspecified unless a value is given.
+  handle                           acquire      (const multi_size_type& size)
+  {
+    auto result = take(size);
+    reshape(result, size);
+    return handle(this, std::move(result));
+  }
+  handle                           acquire      (const multi_size_type& size, const value_type& value)
+  {
+    auto result = take(size);
+    reshape(result, size);
+    std::fill(result.begin(), result.end(), value);
+    return handle(this, std::move(result));
+  }
+
+  // Adds a vector to the free list of the calling thread. Vectors which cannot be stored are destroyed.
+  void                             recycle      (vector_type&& vector) noexcept
+  {
+    if (vector.capacity() == 0)
+      return;
+
+    auto& shard = local_shard();
+    std::lock_guard lock(shard.mutex);
+    try
+    {
+      shard.free_lists[std::bit_width(vector.capacity()) - 1].push_back(std::move(vector));
+    }
+    catch (...)
+    {
+
+    }
+  }
+
+  size_type                        cached_count () const
+  {
+    size_type result = 0;
+    for (size_type i = 0; i < shard_count_; ++i)
+    {
+      std::lock_guard lock(shards_[i].mutex);
+      for (const auto& free_list : shards_[i].free_lists)
+        result += free_list.size();
+    }
+    return result;
+  }
+  void                             clear        ()
+  {
+    for (size_type i = 0; i < shard_count_; ++i)
+    {
+      std::lock_guard lock(shards_[i].mutex);
+      for (auto& free_list : shards_[i].free_lists)
+        free_list.clear();
+    }
+  }
+
+  allocator_type                   get_allocator() const noexcept
+  {
+    return allocator_;
+  }
+
+  // Smallest size class whose capacity, 2^class, holds the linear size.
+  static constexpr size_type       size_class   (size_type linear_size) noexcept
+  {
+    return linear_size > 1 ? std::bit_width(linear_size - 1) : 0;
+  }
+
+protected:
+  struct alignas(64) shard
+  {
+    mutable std::mutex                                     mutex     ;
+    std::array<std::vector<vector_type>, size_class_count> free_lists;
+  };
+
+  shard&                           local_shard  () const noexcept
+  {
+    return shards_[std::hash<std::thread::id>()(std::this_thread::get_id()) % shard_count_];
+  }
+
+  static constexpr size_type       linear_size  (const multi_size_type& size) noexcept
+  {
+    size_type result = 1;
+    for (const auto extent : size)
+      result *= extent;
+    return result;
+  }
+  static constexpr void            reshape      (vector_type& vector, const multi_size_type& size)
+  {
+    if constexpr (_dimensions == 1)
+      vector.resize(size[0]);
+    else
+      vector.resize(size);
+  }
+
+  // Pops a vector of the size class of the local shard, or creates one with the whole class capacity touched.
+  vector_type                      take         (const multi_size_type& size)
+  {
+    const auto size_class = buffer_pool::size_class(linear_size(size));
+    {
+      auto& shard = local_shard();
+      std::lock_guard lock(shard.mutex);
+      if (auto& free_list = shard.free_lists[size_class]; !free_list.empty())
+      {
+        auto result = std::move(free_list.back());
+        free_list.pop_back();
+        return result;
+      }
+    }
+
+    multi_size_type capacity;
+    capacity.fill(1);
+    capacity[0] = size_type(1) << size_class;
+
+    vector_type result(allocator_);
+    result.reserve(capacity[0]);
+    reshape(result, capacity);
+    return result;
+  }
+
+  allocator_type           allocator_  ;
+  size_type                shard_count_;
+  std::unique_ptr<shard[]> shards_     ;
+};
+}
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <multi/execution.hpp>
+#include <multi/vector.hpp>
+
+namespace multi
+{
+// Immutable, run-length encoded hyper-rectangular storage. The last dimension is encoded as rows of runs, and slices
+// (consecutive rows sharing all but the last two coordinates) which consist of a single value are collapsed to it.
+template <
+  typename    _type      ,
+  std::size_t _dimensions>
+class compressed_vector
+{
+public:
+  using value_type             = _type;
+  using size_type              = std::size_t;
+  using difference_type        = std::ptrdiff_t;
+  using multi_size_type        = std::array<size_type, _dimensions>;
+
+  static constexpr size_type constant_slice = std::numeric_limits<size_type>::max();
+
+  constexpr          compressed_vector() = default;
+  template <typename _accessor, typename _allocator, typename _execution_policy = const execution::sequenced_policy&>
+  explicit           compressed_vector(const vector<_type, _dimensions, std::experimental::layout_right, _accessor, _allocator>& source, _execution_policy&& policy = execution::seq)
+  : dimensions_(source.dimensions())
+  {
+    const auto row_size    = this->row_size   ();
+    const auto slice_rows  = this->slice_rows ();
+    const auto slice_count = this->slice_count();
+
+    struct encoded_slice
+    {
+      std::vector<size_type>  row_offsets;
+      std::vector<size_type>  run_ends   ;
+      std::vector<value_type> run_values ;
+    };
+    std::vector<encoded_slice> encoded(slice_count);
+    slice_offsets_.resize(slice_count);
+    slice_values_ .resize(slice_count);
+
+    for_each_index(policy, slice_count, [&] (const size_type slice)
+    {
+      const auto first = source.data() + slice * slice_rows * row_size;
+      const auto last  = first + slice_rows * row_size;
+      if (first != last && std::all_of(first, last, [&] (const value_type& value) { return value == *first; }))
+      {
+        slice_offsets_[slice] = constant_slice;
+        slice_values_ [slice] = *first;
+        return;
+      }
+
+      auto& target = encoded[slice];
+      target.row_offsets.reserve(slice_rows);
+      for (size_type row = 0; row < slice_rows; ++row)
+      {
+        target.row_offsets.push_back(target.run_ends.size());
+        const auto row_first = first + row * row_size;
+        for (size_type column = 0; column < row_size;)
+        {
+          const auto value = row_first[column];
+          while (++column < row_size && row_first[column] == value);
+          target.run_ends  .push_back(column);
+          target.run_values.push_back(value );
+        }
+      }
+    });
+
+    size_type row_count = 0, run_count = 0;
+    std::vector<size_type> run_bases(slice_count);
+    for (size_type slice = 0; slice < slice_count; ++slice)
+    {
+      if (slice_offsets_[slice] == constant_slice)
+        continue;
+      slice_offsets_[slice] = row_count;
+      run_bases     [slice] = run_count;
+      row_count            += slice_rows;
+      run_count            += encoded[slice].run_ends.size();
+    }
+
+    row_offsets_.resize(row_count + 1);
+    run_ends_   .resize(run_count);
+    run_values_ .resize(run_count);
+    row_offsets_.back() = run_count;
+    for_each_index(policy, slice_count, [&] (const size_type slice)
+    {
+      if (slice_offsets_[slice] == constant_slice)
+        return;
+
+      const auto& source_slice = encoded[slice];
+      std::transform(source_slice.row_offsets.begin(), source_slice.row_offsets.end(), row_offsets_.begin() + slice_offsets_[slice], [&] (const size_type offset)
+      {
+        return offset + run_bases[slice];
+      });
+      std::copy(source_slice.run_ends  .begin(), source_slice.run_ends  .end(), run_ends_  .begin() + run_bases[slice]);
+      std::copy(source_slice.run_values.begin(), source_slice.run_values.end(), run_values_.begin() + run_bases[slice]);
+    });
+  }
+  constexpr          compressed_vector(const compressed_vector&  that) = default;
+  constexpr          compressed_vector(      compressed_vector&& temp) noexcept = default;
+  constexpr         ~compressed_vector() = default;
+
+  constexpr compressed_vector&     operator=    (const compressed_vector&  that) = default;
+  constexpr compressed_vector&     operator=    (      compressed_vector&& temp) noexcept = default;
+
+  // Element access (by value, as elements are not stored individually).
+
+  constexpr value_type             at           (const multi_size_type& position) const
+  {
+    for (size_type i = 0; i < _dimensions; ++i)
+      if (position[i] >= dimensions_[i])
+        throw std::out_of_range("multi::compressed_vector::at");
+    return operator()(position);
+  }
+  template <typename... _positions>
+  constexpr value_type             at           (_positions...          position) const
+  {
+    return at(multi_size_type {static_cast<size_type>(position)...});
+  }
+
+  constexpr value_type             operator[]   (const multi_size_type& position) const
+  {
+    return operator()(position);
+  }
+
+  constexpr value_type             operator()   (const multi_size_type& position) const
+  {
+    size_type row = 0;
+    for (size_type i = 0; i + 1 < _dimensions; ++i)
+      row = row * dimensions_[i] + position[i];
+
+    const auto slice_rows = this->slice_rows();
+    const auto offset     = slice_offsets_[row / slice_rows];
+    if (offset == constant_slice)
+      return slice_values_[row / slice_rows];
+
+    const auto index = offset + row % slice_rows;
+    const auto first = run_ends_.begin() + row_offsets_[index    ];
+    const auto last  = run_ends_.begin() + row_offsets_[index + 1];
+    return run_values_[std::upper_bound(first, last, position.back()) - run_ends_.begin()];
+  }
+  template <typename... _positions>
+  constexpr value_type             operator()   (_positions...          position) const
+  {
+    return operator()(multi_size_type {static_cast<size_type>(position)...});
+  }
+
+  // Writes the row_size() elements of the given row (linear index over all but the last dimension) to output.
+  template <typename _output_iterator>
+  constexpr _output_iterator       decode_row   (size_type row, _output_iterator output) const
+  {
+    const auto slice_rows = this->slice_rows();
+    const auto offset     = slice_offsets_[row / slice_rows];
+    if (offset == constant_slice)
+      return std::fill_n(output, row_size(), slice_values_[row / slice_rows]);
+
+    const auto index = offset + row % slice_rows;
+    size_type  begin = 0;
+    for (auto run = row_offsets_[index]; run < row_offsets_[index + 1]; ++run)
+    {
+      output = std::fill_n(output, run_ends_[run] - begin, run_values_[run]);
+      begin  = run_ends_[run];
+    }
+    return output;
+  }
+
+  template <typename _execution_policy = const execution::sequenced_policy&>
+  vector<_type, _dimensions>       decompress   (_execution_policy&& policy = execution::seq) const
+  {
+    vector<_type, _dimensions> result;
+    if constexpr (_dimensions == 1)
+      result.resize(dimensions_[0]);
+    else
+      result.resize(dimensions_);
+
+    if (result.empty())
+      return result;
+
+    const auto row_size = this->row_size();
+    for_each_index(policy, row_count(), [&] (const size_type row)
+    {
+      decode_row(row, result.data() + row * row_size);
+    });
+    return result;
+  }
+
+  // Capacity.
+
+  constexpr bool                   empty        () const noexcept
+  {
+    return size() == 0;
+  }
+  constexpr size_type              size         () const noexcept
+  {
+    return std::accumulate(dimensions_.begin(), dimensions_.end(), static_cast<size_type>(1), std::multiplies<size_type>());
+  }
+  constexpr multi_size_type        dimensions   () const noexcept
+  {
+    return dimensions_;
+  }
+  constexpr size_type              row_size     () const noexcept
+  {
+    return dimensions_.back();
+  }
+  constexpr size_type              row_count    () const noexcept
+  {
+    return std::accumulate(dimensions_.begin(), dimensions_.end() - 1, static_cast<size_type>(1), std::multiplies<size_type>());
+  }
+  constexpr size_type              run_count    () const noexcept
+  {
+    return run_ends_.size();
+  }
+  // Bytes occupied by the encoded representation.
+  constexpr size_type              memory_size  () const noexcept
+  {
+    return slice_offsets_.size() * sizeof(size_type ) +
+           slice_values_ .size() * sizeof(value_type) +
+           row_offsets_  .size() * sizeof(size_type ) +
+           run_ends_     .size() * sizeof(size_type ) +
+           run_values_   .size() * sizeof(value_type);
+  }
+
+  // Operations.
+
+  constexpr void                   swap         (compressed_vector& that) noexcept
+  {
+    std::swap(dimensions_   , that.dimensions_   );
+    std::swap(slice_offsets_, that.slice_offsets_);
+    std::swap(slice_values_ , that.slice_values_ );
+    std::swap(row_offsets_  , that.row_offsets_  );
+    std::swap(run_ends_     , that.run_ends_     );
+    std::swap(run_values_   , that.run_values_   );
+  }
+
+protected:
+  constexpr size_type              slice_rows   () const noexcept
+  {
+    if constexpr (_dimensions > 1)
+      return std::max<size_type>(dimensions_[_dimensions - 2], 1);
+    else
+      return 1;
+  }
+  constexpr size_type              slice_count  () const noexcept
+  {
+    return row_count() / slice_rows();
+  }
+
+  multi_size_type         dimensions_    {};
+  std::vector<size_type>  slice_offsets_ ; // Index of the first row in row_offsets_, or constant_slice.
+  std::vector<value_type> slice_values_  ; // Value of constant slices.
+  std::vector<size_type>  row_offsets_   ; // Index of the first run of each row, with a trailing sentinel.
+  std::vector<size_type>  run_ends_      ; // Exclusive end column of each run.
+  std::vector<value_type> run_values_    ;
+};
+
+// Non-member functions.
+
+template <typename _type, std::size_t _dimensions>
+constexpr void swap(
+  compressed_vector<_type, _dimensions>& lhs,
+  compressed_vector<_type, _dimensions>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <multi/execution.hpp>
+#include <multi/half.hpp>
+#include <multi/vector.hpp>
+
+namespace multi
+{
+// Codecs convert between a compact storage type and the value type seen through the accessor, per element and in bulk.
+
+struct float16_codec
+{
+  using value_type   = float;
+  using storage_type = float16;
+
+  constexpr value_type   decode(const storage_type& value) const noexcept
+  {
+    return float16::to_float(value.bits);
+  }
+  constexpr storage_type encode(const value_type&   value) const noexcept
+  {
+    return storage_type(value);
+  }
+  void                   decode(const storage_type* first, const storage_type* last, value_type*   output) const noexcept
+  {
+    convert(first, last, output);
+  }
+  void                   encode(const value_type*   first, const value_type*   last, storage_type* output) const noexcept
+  {
+    convert(first, last, output);
+  }
+};
+
+struct bfloat16_codec
+{
+  using value_type   = float;
+  using storage_type = bfloat16;
+
+  constexpr value_type   decode(const storage_type& value) const noexcept
+  {
+    return bfloat16::to_float(value.bits);
+  }
+  constexpr storage_type encode(const value_type&   value) const noexcept
+  {
+    return storage_type(value);
+  }
+  void                   decode(const storage_type* first, const storage_type* last, value_type*   output) const noexcept
+  {
+    convert(first, last, output);
+  }
+  void                   encode(const value_type*   first, const value_type*   last, storage_type* output) const noexcept
+  {
+    convert(first, last, output);
+  }
+};
+
+// Linear quantization: value = stored * scale + offset. Encoding rounds to nearest and saturates (NaN encodes to 0).
+template <typename _storage_type>
+struct quantized_codec
+{
+  // The maximum of wider types is not representable as a float, and saturated values would overflow on conversion.
+  static_assert(std::is_integral_v<_storage_type> && std::is_unsigned_v<_storage_type> && sizeof(_storage_type) <= 2, "Quantized storage must be an unsigned integer type of 8 or 16 bits.");
+
+  using value_type   = float;
+  using storage_type = _storage_type;
+
+  constexpr value_type   decode(const storage_type& value) const noexcept
+  {
+    return static_cast<value_type>(value) * scale + offset;
+  }
+  constexpr storage_type encode(const value_type&   value) const noexcept
+  {
+    return quantize(value, 1.0f / scale);
+  }
+  void                   decode(const storage_type* first, const storage_type* last, value_type*   output) const noexcept
+  {
+    for (; first != last; ++first, ++output)
+      *output = decode(*first);
+  }
+  void                   encode(const value_type*   first, const value_type*   last, storage_type* output) const noexcept
+  {
+    const auto inverse_scale = 1.0f / scale;
+    for (; first != last; ++first, ++output)
+      *output = quantize(*first, inverse_scale);
+  }
+
+  value_type scale  = 1.0f;
+  value_type offset = 0.0f;
+
+protected:
+  constexpr storage_type quantize(value_type value, value_type inverse_scale) const noexcept
+  {
+    constexpr auto maximum = static_cast<value_type>(std::numeric_limits<storage_type>::max());
+    value = (value - offset) * inverse_scale;
+    value = value > 0.0f    ? value : 0.0f;
+    value = value < maximum ? value : maximum;
+    return static_cast<storage_type>(value + 0.5f);
+  }
+};
+
+template <typename _codec>
+class conversion_reference
+{
+public:
+  using value_type   = typename _codec::value_type;
+  using storage_type = typename _codec::storage_type;
+
+  constexpr conversion_reference(storage_type& storage, const _codec& codec) noexcept
+  : storage_(&storage), codec_(codec)
+  {
+
+  }
+  constexpr conversion_reference(const conversion_reference& that) noexcept = default;
+
+  constexpr conversion_reference& operator= (const value_type& value) noexcept
+  {
+    *storage_ = codec_.encode(value);
+    return *this;
+  }
+  constexpr conversion_reference& operator= (const conversion_reference& that) noexcept
+  {
+    return operator=(static_cast<value_type>(that));
+  }
+  constexpr conversion_reference& operator+=(const value_type& value) noexcept
+  {
+    return operator=(static_cast<value_type>(*this) + value);
+  }
+  constexpr conversion_reference& operator-=(const value_type& value) noexcept
+  {
+    return operator=(static_cast<value_type>(*this) - value);
+  }
+  constexpr conversion_reference& operator*=(const value_type& value) noexcept
+  {
+    return operator=(static_cast<value_type>(*this) * value);
+  }
+  constexpr conversion_reference& operator/=(const value_type& value) noexcept
+  {
+    return operator=(static_cast<value_type>(*this) / value);
+  }
+  constexpr operator value_type() const noexcept
+  {
+    return codec_.decode(*storage_);
+  }
+
+protected:
+  storage_type* storage_;
+  _codec        codec_  ;
+};
+
+// Accessor which stores elements as _codec::storage_type and exposes them as _codec::value_type through proxies.
+template <typename _codec>
+class conversion_accessor
+{
+public:
+  using codec_type    = _codec;
+  using offset_policy = conversion_accessor;
+  using element_type  = typename codec_type::storage_type;
+  using reference     = conversion_reference<codec_type>;
+  using pointer       = element_type*;
+
+  constexpr          conversion_accessor() noexcept = default;
+  constexpr explicit conversion_accessor(const codec_type& codec) noexcept
+  : codec_(codec)
+  {
+
+  }
+
+  constexpr pointer           offset(pointer p, std::size_t i) const noexcept
+  {
+    return p + i;
+  }
+  constexpr reference         access(pointer p, std::size_t i) const noexcept
+  {
+    return reference(p[i], codec_);
+  }
+
+  constexpr const codec_type& codec () const noexcept
+  {
+    return codec_;
+  }
+
+protected:
+  codec_type codec_ {};
+};
+
+using float16_accessor  = conversion_accessor<float16_codec >;
+using bfloat16_accessor = conversion_accessor<bfloat16_codec>;
+template <typename _storage_type>
+using quantized_accessor = conversion_accessor<quantized_codec<_storage_type>>;
+
+namespace detail
+{
+inline constexpr std::size_t conversion_chunk_size = 16384;
+
+template <typename _vector_type, typename _multi_size_type>
+constexpr void resize(_vector_type& vector, const _multi_size_type& size)
+{
+  if constexpr (std::tuple_size_v<_multi_size_type> == 1)
+    vector.resize(size[0]);
+  else
+    vector.resize(size);
+}
+
+template <typename _source, typename _target>
+inline constexpr bool same_layout = std::is_same_v<
+  typename std::remove_cvref_t<decltype(std::declval<const _source&>().span())>::layout_type,
+  typename std::remove_cvref_t<decltype(std::declval<const _target&>().span())>::layout_type>;
+}
+
+// Whole-container conversions through the codec of the target's (encode) or the source's (decode) accessor. The
+// target is resized to the dimensions of the source, and chunks of elements are converted concurrently. Elements are
+// converted in storage order, so the source and the target must have the same layout.
+template <typename _source, typename _type, std::size_t _dimensions, typename _layout, typename _codec, typename _allocator, typename _execution_policy = const execution::sequenced_policy&>
+void encode(const _source& source, vector<_type, _dimensions, _layout, conversion_accessor<_codec>, _allocator>& target, _execution_policy&& policy = execution::seq)
+{
+  static_assert(detail::same_layout<_source, std::remove_cvref_t<decltype(target)>>, "The source and the target must have the same layout.");
+  detail::resize(target, source.dimensions());
+
+  const auto size  = source.size();
+  const auto codec = target.get_accessor().codec();
+  for_each_index(policy, (size + detail::conversion_chunk_size - 1) / detail::conversion_chunk_size, [&] (const std::size_t chunk)
+  {
+    const auto begin = chunk * detail::conversion_chunk_size;
+    const auto end   = std::min(begin + detail::conversion_chunk_size, size);
+    codec.encode(source.data() + begin, source.data() + end, target.data() + begin);
+  });
+}
+template <typename _type, std::size_t _dimensions, typename _layout, typename _codec, typename _allocator, typename _target, typename _execution_policy = const execution::sequenced_policy&>
+void decode(const vector<_type, _dimensions, _layout, conversion_accessor<_codec>, _allocator>& source, _target& target, _execution_policy&& policy = execution::seq)
+{
+  static_assert(detail::same_layout<std::remove_cvref_t<decltype(source)>, _target>, "The source and the target must have the same layout.");
+  detail::resize(target, source.dimensions());
+
+  const auto size  = source.size();
+  const auto codec = source.get_accessor().codec();
+  for_each_index(policy, (size + detail::conversion_chunk_size - 1) / detail::conversion_chunk_size, [&] (const std::size_t chunk)
+  {
+    const auto begin = chunk * detail::conversion_chunk_size;
+    const auto end   = std::min(begin + detail::conversion_chunk_size, size);
+    codec.decode(source.data() + begin, source.data() + end, target.data() + begin);
+  });
+}
+}
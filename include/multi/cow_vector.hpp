@@ -0,0 +1,635 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <multi/ndindex.hpp>
+#include <multi/nested_for.hpp>
+#include <multi/third_party/mdspan.hpp>
+#include <multi/vector.hpp>
+
+namespace multi
+{
+// Layout of hyper-rectangular tiles of _tile_size^N elements, each stored contiguously in layout_right order, with the
+// tiles in layout_right order of the tile grid. Edge tiles are padded to full size.
+template <std::size_t _tile_size>
+struct layout_tiled
+{
+  template <typename _extents>
+  class mapping
+  {
+  public:
+    using layout_type  = layout_tiled;
+    using extents_type = _extents;
+    using size_type    = typename _extents::size_type;
+
+    static constexpr size_type tile_volume() noexcept
+    {
+      size_type result = 1;
+      for (size_type i = 0; i < _extents::rank(); ++i)
+        result *= _tile_size;
+      return result;
+    }
+
+    constexpr mapping() noexcept = default;
+    constexpr mapping(const _extents& extents) noexcept
+    : extents_(extents)
+    {
+      size_type stride = 1;
+      for (auto i = _extents::rank(); i-- > 0;)
+      {
+        tile_strides_[i] = stride;
+        stride          *= (extents_.extent(i) + _tile_size - 1) / _tile_size;
+      }
+      tile_count_ = stride;
+    }
+
+    template <typename... _indices>
+    constexpr size_type    operator()        (_indices... indices) const noexcept
+    {
+      const std::array<size_type, _extents::rank()> position {static_cast<size_type>(indices)...};
+      size_type tile = 0, local = 0;
+      for (size_type i = 0; i < _extents::rank(); ++i)
+      {
+        tile  += position[i] / _tile_size * tile_strides_[i];
+        local  = local * _tile_size + position[i] % _tile_size;
+      }
+      return tile * tile_volume() + local;
+    }
+
+    constexpr _extents     extents           () const noexcept
+    {
+      return extents_;
+    }
+    constexpr size_type    required_span_size() const noexcept
+    {
+      return tile_count_ * tile_volume();
+    }
+    constexpr size_type    tile_count        () const noexcept
+    {
+      return tile_count_;
+    }
+    constexpr size_type    tile_stride       (size_type axis) const noexcept
+    {
+      return tile_strides_[axis];
+    }
+
+    static constexpr bool  is_always_unique    () noexcept { return true ; }
+    static constexpr bool  is_always_contiguous() noexcept { return false; }
+    static constexpr bool  is_always_strided   () noexcept { return false; }
+    constexpr bool         is_unique           () const noexcept { return true ; }
+    constexpr bool         is_contiguous       () const noexcept { return false; }
+    constexpr bool         is_strided          () const noexcept { return false; }
+
+    template <typename _other_extents>
+    friend constexpr bool  operator==(const mapping& lhs, const mapping<_other_extents>& rhs) noexcept
+    {
+      return lhs.extents() == rhs.extents();
+    }
+
+  protected:
+    _extents                                extents_      {};
+    std::array<size_type, _extents::rank()> tile_strides_ {};
+    size_type                               tile_count_   = 0;
+  };
+};
+
+// Accessor over offsets of layout_tiled into an array of tile pointers. Offsets must be multiples of the tile volume.
+template <typename _type, std::size_t _tile_volume>
+struct tile_accessor
+{
+  using offset_policy = tile_accessor;
+  using element_type  = _type;
+  using reference     = _type&;
+  using pointer       = _type* const*;
+
+  constexpr pointer   offset(pointer p, std::size_t i) const noexcept
+  {
+    return p + i / _tile_volume;
+  }
+  constexpr reference access(pointer p, std::size_t i) const noexcept
+  {
+    return p[i / _tile_volume][i % _tile_volume];
+  }
+};
+
+// Random access iterator over the elements of a span, or over (reference, position) pairs if _indexed, in layout_right
+// order of the positions. Unlike indexed_iterator, any layout is supported: each dereference maps the position.
+template <typename _span, bool _indexed = false>
+class position_order_iterator
+{
+public:
+  using position_iterator = ndindex_iterator<_span::rank()>;
+  using multi_size_type   = typename position_iterator::multi_size_type;
+  using iterator_concept  = std::random_access_iterator_tag;
+  using iterator_category = std::conditional_t<_indexed, std::input_iterator_tag, std::random_access_iterator_tag>;
+  using value_type        = std::conditional_t<_indexed, std::pair<typename _span::reference, multi_size_type>, typename _span::value_type>;
+  using difference_type   = std::ptrdiff_t;
+  using reference         = std::conditional_t<_indexed, value_type, typename _span::reference>;
+
+  constexpr position_order_iterator() noexcept = default;
+  constexpr position_order_iterator(const _span& span, difference_type index) noexcept
+  : span_(&span)
+  {
+    multi_size_type extents;
+    for (std::size_t i = 0; i < _span::rank(); ++i)
+      extents[i] = span.extent(i);
+    position_ = coords(extents).begin() + index;
+  }
+
+  constexpr reference                operator* () const
+  {
+    if constexpr (_indexed)
+      return {(*span_)(*position_), *position_};
+    else
+      return (*span_)(*position_);
+  }
+  constexpr reference                operator[](difference_type n) const
+  {
+    return *(*this + n);
+  }
+
+  constexpr position_order_iterator& operator++() noexcept
+  {
+    ++position_;
+    return *this;
+  }
+  constexpr position_order_iterator  operator++(int) noexcept
+  {
+    auto result = *this;
+    ++position_;
+    return result;
+  }
+  constexpr position_order_iterator& operator--() noexcept
+  {
+    --position_;
+    return *this;
+  }
+  constexpr position_order_iterator  operator--(int) noexcept
+  {
+    auto result = *this;
+    --position_;
+    return result;
+  }
+
+  constexpr position_order_iterator& operator+=(difference_type n) noexcept
+  {
+    position_ += n;
+    return *this;
+  }
+  constexpr position_order_iterator& operator-=(difference_type n) noexcept
+  {
+    position_ -= n;
+    return *this;
+  }
+  friend constexpr position_order_iterator operator+(position_order_iterator iterator, difference_type n) noexcept
+  {
+    return iterator += n;
+  }
+  friend constexpr position_order_iterator operator+(difference_type n, position_order_iterator iterator) noexcept
+  {
+    return iterator += n;
+  }
+  friend constexpr position_order_iterator operator-(position_order_iterator iterator, difference_type n) noexcept
+  {
+    return iterator -= n;
+  }
+  friend constexpr difference_type         operator-(const position_order_iterator& lhs, const position_order_iterator& rhs) noexcept
+  {
+    return lhs.position_ - rhs.position_;
+  }
+
+  friend constexpr bool                 operator== (const position_order_iterator& lhs, const position_order_iterator& rhs) noexcept
+  {
+    return lhs.position_ == rhs.position_;
+  }
+  friend constexpr std::strong_ordering operator<=>(const position_order_iterator& lhs, const position_order_iterator& rhs) noexcept
+  {
+    return lhs.position_ <=> rhs.position_;
+  }
+
+protected:
+  const _span*      span_     = nullptr;
+  position_iterator position_ ;
+};
+
+// Hyper-rectangular storage of reference counted tiles of _tile_size^_dimensions elements, shared between copies.
+// Copies cost O(tiles), and non-const element or tile access copies the enclosing tile if it is shared, so that
+// memory grows with the modified tiles only. Constructed and filled containers share a single tile throughout.
+// Copies may be read concurrently with the modification of one another, but a container must not be modified
+// concurrently with its copying. Linear indices and iteration follow the layout_right order of the positions, not the
+// tiled storage order. Iterators are const: a mutable element reference would have to unshare its tile on access.
+template <
+  typename    _type      ,
+  std::size_t _dimensions,
+  std::size_t _tile_size = 16>
+class cow_vector
+{
+public:
+  using layout_type            = layout_tiled<_tile_size>;
+  using extents_type           = std::experimental::dextents<_dimensions>;
+  using mapping_type           = typename layout_type::template mapping<extents_type>;
+
+  using tile_type              = std::array<_type, mapping_type::tile_volume()>;
+  using tile_pointer           = std::shared_ptr<tile_type>;
+  using tiles_type             = std::vector<tile_pointer>;
+  using span_type              = std::experimental::mdspan<const _type, extents_type, layout_type, tile_accessor<const _type, mapping_type::tile_volume()>>;
+
+  using value_type             = _type;
+  using size_type              = std::size_t;
+  using difference_type        = std::ptrdiff_t;
+  using reference              = value_type&;
+  using const_reference        = const value_type&;
+  using const_iterator         = position_order_iterator<span_type>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using const_indexed_type     = std::ranges::subrange<position_order_iterator<span_type, true>>;
+
+  using multi_size_type        = std::array<size_type, _dimensions>;
+
+  constexpr          cow_vector() = default;
+  constexpr explicit cow_vector(const multi_size_type& size, const_reference value = value_type())
+  : dimensions_(size), mapping_(extents_type(size))
+  {
+    fill(value);
+  }
+  template <typename _layout, typename _accessor, typename _allocator, typename _extents>
+  constexpr explicit cow_vector(const vector<_type, _dimensions, _layout, _accessor, _allocator, _extents>& that)
+  : cow_vector(that.dimensions())
+  {
+    for (auto& tile : tiles_)
+      tile = std::make_shared<tile_type>(*tile);
+    update_tile_data();
+
+    nested_for(dimensions_, [&] (const multi_size_type& position)
+    {
+      const auto offset = std::apply(mapping_, position);
+      tiles_[offset / tile_volume()]->at(offset % tile_volume()) = that[position];
+    });
+  }
+
+  constexpr          cow_vector(const cow_vector&  that)
+  : dimensions_(that.dimensions_), mapping_(that.mapping_), tiles_(that.tiles_), tile_data_(that.tile_data_)
+  {
+    update_span();
+  }
+  constexpr          cow_vector(      cow_vector&& temp) noexcept
+  : dimensions_(std::exchange(temp.dimensions_, {})), mapping_(std::exchange(temp.mapping_, {})), tiles_(std::move(temp.tiles_)), tile_data_(std::move(temp.tile_data_))
+  {
+    update_span();
+    temp.tiles_    .clear();
+    temp.tile_data_.clear();
+    temp.span_ = {};
+  }
+
+  constexpr         ~cow_vector() = default;
+
+  constexpr cow_vector&            operator=    (const cow_vector&  that)
+  {
+    if (this != &that)
+    {
+      cow_vector copy(that);
+      swap(copy);
+    }
+    return *this;
+  }
+  constexpr cow_vector&            operator=    (      cow_vector&& temp) noexcept
+  {
+    if (this != &temp)
+    {
+      cow_vector copy(std::move(temp));
+      swap(copy);
+    }
+    return *this;
+  }
+
+  // Element access.
+
+  constexpr reference              at           (size_type              position)
+  {
+    if (position >= size())
+      throw std::out_of_range("multi::cow_vector::at");
+    return operator()(position_of(position));
+  }
+  constexpr const_reference        at           (size_type              position) const
+  {
+    if (position >= size())
+      throw std::out_of_range("multi::cow_vector::at");
+    return operator()(position_of(position));
+  }
+  constexpr reference              at           (const multi_size_type& position)
+  {
+    check_bounds(position);
+    return operator()(position);
+  }
+  constexpr const_reference        at           (const multi_size_type& position) const
+  {
+    check_bounds(position);
+    return operator()(position);
+  }
+  template <typename... _positions>
+  constexpr reference              at           (_positions...          position)
+  {
+    return at(multi_size_type {static_cast<size_type>(position)...});
+  }
+  template <typename... _positions>
+  constexpr const_reference        at           (_positions...          position) const
+  {
+    return at(multi_size_type {static_cast<size_type>(position)...});
+  }
+
+  constexpr reference              operator[]   (size_type              position)
+  {
+    return operator()(position_of(position));
+  }
+  constexpr const_reference        operator[]   (size_type              position) const
+  {
+    return operator()(position_of(position));
+  }
+  constexpr reference              operator[]   (const multi_size_type& position)
+  {
+    return operator()(position);
+  }
+  constexpr const_reference        operator[]   (const multi_size_type& position) const
+  {
+    return operator()(position);
+  }
+
+  constexpr reference              operator()   (const multi_size_type& position)
+  {
+    const auto offset = std::apply(mapping_, position);
+    return make_unique(offset / tile_volume())[offset % tile_volume()];
+  }
+  constexpr const_reference        operator()   (const multi_size_type& position) const
+  {
+    return span_(position);
+  }
+  template <typename... _positions>
+  constexpr reference              operator()   (_positions...          position)
+  {
+    return operator()(multi_size_type {static_cast<size_type>(position)...});
+  }
+  template <typename... _positions>
+  constexpr const_reference        operator()   (_positions...          position) const
+  {
+    return operator()(multi_size_type {static_cast<size_type>(position)...});
+  }
+
+  constexpr reference              front        ()
+  {
+    return operator()(multi_size_type {});
+  }
+  constexpr const_reference        front        () const
+  {
+    return operator()(multi_size_type {});
+  }
+  constexpr reference              back         ()
+  {
+    return operator()(position_of(size() - 1));
+  }
+  constexpr const_reference        back         () const
+  {
+    return operator()(position_of(size() - 1));
+  }
+
+  // Tile access.
+
+  // The tile at the position in the tile grid, copied first if it is shared.
+  constexpr tile_type&             tile         (const multi_size_type& tile_position)
+  {
+    return make_unique(tile_index(tile_position));
+  }
+  constexpr const tile_type&       tile         (const multi_size_type& tile_position) const
+  {
+    return *tiles_[tile_index(tile_position)];
+  }
+  // Whether the tile is referenced by another container or elsewhere in this one.
+  constexpr bool                   shared       (const multi_size_type& tile_position) const
+  {
+    return tiles_[tile_index(tile_position)].use_count() != 1;
+  }
+
+  // Iterators.
+
+  constexpr const_iterator         begin        () const noexcept
+  {
+    return const_iterator(span_, 0);
+  }
+  constexpr const_iterator         cbegin       () const noexcept
+  {
+    return begin();
+  }
+  constexpr const_iterator         end          () const noexcept
+  {
+    return const_iterator(span_, static_cast<difference_type>(size()));
+  }
+  constexpr const_iterator         cend         () const noexcept
+  {
+    return end();
+  }
+
+  constexpr const_reverse_iterator rbegin       () const noexcept
+  {
+    return const_reverse_iterator(end());
+  }
+  constexpr const_reverse_iterator crbegin      () const noexcept
+  {
+    return rbegin();
+  }
+  constexpr const_reverse_iterator rend         () const noexcept
+  {
+    return const_reverse_iterator(begin());
+  }
+  constexpr const_reverse_iterator crend        () const noexcept
+  {
+    return rend();
+  }
+
+  // Elements with their positions, in layout_right order.
+  constexpr const_indexed_type     indexed      () const noexcept
+  {
+    using iterator = std::ranges::iterator_t<const_indexed_type>;
+    return const_indexed_type(iterator(span_, 0), iterator(span_, static_cast<difference_type>(size())));
+  }
+
+  // Capacity.
+
+  constexpr bool                   empty        () const noexcept
+  {
+    return size() == 0;
+  }
+  constexpr size_type              size         () const noexcept
+  {
+    size_type result = 1;
+    for (const auto dimension : dimensions_)
+      result *= dimension;
+    return result;
+  }
+  constexpr multi_size_type        dimensions   () const noexcept
+  {
+    return dimensions_;
+  }
+  constexpr size_type              tile_count   () const noexcept
+  {
+    return tiles_.size();
+  }
+  static constexpr size_type       tile_volume  () noexcept
+  {
+    return mapping_type::tile_volume();
+  }
+
+  // Modifiers.
+
+  constexpr void                   clear        () noexcept
+  {
+    dimensions_ = {};
+    mapping_    = {};
+    tiles_    .clear();
+    tile_data_.clear();
+    span_       = {};
+  }
+  // Replaces every tile with a single shared one.
+  constexpr void                   fill         (const_reference value)
+  {
+    const auto tile = std::make_shared<tile_type>();
+    tile->fill(value);
+    tiles_.assign(mapping_.tile_count(), tile);
+    update_tile_data();
+  }
+
+  constexpr void                   swap         (cow_vector& that) noexcept
+  {
+    std::swap(dimensions_, that.dimensions_);
+    std::swap(mapping_   , that.mapping_   );
+    std::swap(tiles_     , that.tiles_     );
+    std::swap(tile_data_ , that.tile_data_ );
+    update_span();
+    that.update_span();
+  }
+
+  // Member access.
+
+  constexpr const tiles_type&      tiles        () const noexcept
+  {
+    return tiles_;
+  }
+  constexpr const span_type&       span         () const noexcept
+  {
+    return span_;
+  }
+
+protected:
+  constexpr size_type              tile_index   (const multi_size_type& tile_position) const noexcept
+  {
+    size_type result = 0;
+    for (size_type i = 0; i < _dimensions; ++i)
+      result += tile_position[i] * mapping_.tile_stride(i);
+    return result;
+  }
+  constexpr tile_type&             make_unique  (size_type index)
+  {
+    auto& tile = tiles_[index];
+    if (tile.use_count() != 1)
+    {
+      tile              = std::make_shared<tile_type>(*tile);
+      tile_data_[index] = tile->data();
+    }
+    else
+      // Reads through released copies happen before the writes.
+      std::atomic_thread_fence(std::memory_order_acquire);
+    return *tile;
+  }
+  // Position of the linear index in layout_right order.
+  constexpr multi_size_type        position_of  (size_type index) const noexcept
+  {
+    multi_size_type result;
+    for (auto i = _dimensions; i-- > 0;)
+    {
+      result[i] = i > 0 ? index % dimensions_[i] : index;
+      index     = i > 0 ? index / dimensions_[i] : 0;
+    }
+    return result;
+  }
+  constexpr void                   check_bounds (const multi_size_type& position) const
+  {
+    for (size_type i = 0; i < _dimensions; ++i)
+      if (position[i] >= dimensions_[i])
+        throw std::out_of_range("multi::cow_vector::at");
+  }
+  constexpr void                   update_tile_data()
+  {
+    tile_data_.resize(tiles_.size());
+    for (size_type i = 0; i < tiles_.size(); ++i)
+      tile_data_[i] = tiles_[i]->data();
+    update_span();
+  }
+  constexpr void                   update_span  ()
+  {
+    span_ = span_type(tile_data_.data(), mapping_);
+  }
+
+  multi_size_type             dimensions_ {};
+  mapping_type                mapping_    ;
+  tiles_type                  tiles_      ;
+  std::vector<const _type*>   tile_data_  ;
+  span_type                   span_       ;
+};
+
+// Non-member functions.
+
+// Tiles shared between the containers are not compared.
+template <typename _type, std::size_t _dimensions, std::size_t _tile_size>
+bool operator==(
+  const cow_vector<_type, _dimensions, _tile_size>& lhs,
+  const cow_vector<_type, _dimensions, _tile_size>& rhs)
+{
+  using multi_size_type = typename cow_vector<_type, _dimensions, _tile_size>::multi_size_type;
+  if (lhs.dimensions() != rhs.dimensions())
+    return false;
+
+  const auto      dimensions = lhs.dimensions();
+  multi_size_type grid;
+  for (std::size_t i = 0; i < _dimensions; ++i)
+    grid[i] = (dimensions[i] + _tile_size - 1) / _tile_size;
+
+  auto result = true;
+  nested_for(grid, [&] (const multi_size_type& tile_position)
+  {
+    const auto& left  = lhs.tile(tile_position);
+    const auto& right = rhs.tile(tile_position);
+    if (!result || &left == &right)
+      return;
+
+    // The elements of edge tiles within the dimensions.
+    multi_size_type end;
+    for (std::size_t i = 0; i < _dimensions; ++i)
+      end[i] = std::min(_tile_size, dimensions[i] - tile_position[i] * _tile_size);
+    nested_for(end, [&] (const multi_size_type& position)
+    {
+      std::size_t offset = 0;
+      for (std::size_t i = 0; i < _dimensions; ++i)
+        offset = offset * _tile_size + position[i];
+      result = result && left[offset] == right[offset];
+    });
+  });
+  return result;
+}
+
+template <typename _type, std::size_t _dimensions, std::size_t _tile_size>
+constexpr void swap(
+  cow_vector<_type, _dimensions, _tile_size>& lhs,
+  cow_vector<_type, _dimensions, _tile_size>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+}
@@ -0,0 +1,410 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <multi/execution.hpp>
+#include <multi/nested_for.hpp>
+#include <multi/thread_pool.hpp>
+#include <multi/vector.hpp>
+
+namespace multi
+{
+// In-process transport: messages are moved through a mailbox. Every block is local.
+// Transports provide local(block), a non-blocking send(source, target, tag, buffer) and a blocking
+// receive(target, source, tag). Sends must not wait for the matching receive.
+template <typename _type>
+class local_transport
+{
+public:
+  using buffer_type = std::vector<_type>;
+
+  local_transport() = default;
+  local_transport(const local_transport&  that) = delete;
+  local_transport(      local_transport&& temp) = delete;
+
+  local_transport& operator=(const local_transport&  that) = delete;
+  local_transport& operator=(      local_transport&& temp) = delete;
+
+  constexpr bool     local  (std::size_t /* block */) const noexcept
+  {
+    return true;
+  }
+  void               send   (std::size_t source, std::size_t target, std::size_t tag, buffer_type&& buffer)
+  {
+    {
+      std::lock_guard lock(mutex_);
+      mailbox_.emplace(key_type(target, source, tag), std::move(buffer));
+    }
+    condition_.notify_all();
+  }
+  buffer_type        receive(std::size_t target, std::size_t source, std::size_t tag)
+  {
+    std::unique_lock lock(mutex_);
+    decltype(mailbox_.begin()) iterator;
+    condition_.wait(lock, [&] { return (iterator = mailbox_.find(key_type(target, source, tag))) != mailbox_.end(); });
+    auto result = std::move(iterator->second);
+    mailbox_.erase(iterator);
+    return result;
+  }
+
+protected:
+  using key_type = std::tuple<std::size_t, std::size_t, std::size_t>;
+
+  std::mutex                         mutex_    ;
+  std::condition_variable            condition_;
+  std::map<key_type, buffer_type>    mailbox_  ;
+};
+
+// Global hyper-rectangular storage partitioned into a grid of blocks. Each block stores its interior with a halo of
+// ghost elements on every side. Halos are filled from the neighbouring interiors (across faces, edges and corners) by
+// exchange_halos, or by begin_exchange and end_exchange around interior computations. Halos on the global boundary are
+// left untouched. The transport decides which blocks are stored locally and moves the packed messages.
+template <
+  typename    _type      ,
+  std::size_t _dimensions,
+  typename    _transport = local_transport<_type>>
+class decomposed_vector
+{
+public:
+  using transport_type  = _transport;
+  using value_type      = _type;
+  using size_type       = std::size_t;
+  using reference       = value_type&;
+  using const_reference = const value_type&;
+  using multi_size_type = std::array<size_type, _dimensions>;
+  using vector_type     = vector<_type, _dimensions>;
+
+  static constexpr size_type direction_count = [ ] { size_type result = 1; for (size_type i = 0; i < _dimensions; ++i) result *= 3; return result; }();
+
+  struct block_type
+  {
+    // Positions are of the interior, relative to the origin.
+    constexpr reference       operator()(const multi_size_type& position)
+    {
+      return data(offset(position));
+    }
+    constexpr const_reference operator()(const multi_size_type& position) const
+    {
+      return data(offset(position));
+    }
+    constexpr multi_size_type offset    (multi_size_type position) const noexcept
+    {
+      for (auto& element : position)
+        element += halo;
+      return position;
+    }
+
+    multi_size_type coordinates; // In the grid of blocks.
+    multi_size_type origin     ; // Global position of the first interior element.
+    multi_size_type extent     ; // Of the interior.
+    size_type       halo       ;
+    vector_type     data       ; // Interior and halos.
+  };
+
+  decomposed_vector(const multi_size_type& size, const multi_size_type& grid, size_type halo, const_reference value = value_type(), transport_type* transport = nullptr)
+  : dimensions_(size), grid_(grid), halo_(halo), transport_(transport)
+  {
+    // Default constructible transports are created when none is given.
+    if (!transport_)
+    {
+      if constexpr (std::is_default_constructible_v<transport_type>)
+        owned_transport_ = std::make_unique<transport_type>();
+      transport_ = owned_transport_.get();
+    }
+
+    for (size_type i = 0; i < _dimensions; ++i)
+      if (!transport_ || grid_[i] == 0 || (halo_ > 0 && size[i] / grid_[i] < halo_))
+        throw std::invalid_argument("multi::decomposed_vector");
+
+    blocks_.resize(block_count());
+    for (size_type index = 0; index < blocks_.size(); ++index)
+    {
+      if (!transport_->local(index))
+        continue;
+
+      auto block = std::make_unique<block_type>();
+      block->coordinates = block_coordinates(index);
+      block->halo        = halo_;
+
+      multi_size_type storage_size;
+      for (size_type i = 0; i < _dimensions; ++i)
+      {
+        const auto [begin, end] = partition_range(size[i], grid_[i], block->coordinates[i]);
+        block->origin[i] = begin;
+        block->extent[i] = end - begin;
+        storage_size [i] = end - begin + 2 * halo_;
+      }
+      if constexpr (_dimensions == 1)
+        block->data = vector_type(storage_size[0], value);
+      else
+        block->data = vector_type(storage_size, value);
+      blocks_[index] = std::move(block);
+    }
+  }
+  decomposed_vector(const decomposed_vector&  that) = delete;
+  decomposed_vector(      decomposed_vector&& temp) = default;
+  ~decomposed_vector() = default;
+
+  decomposed_vector&               operator=    (const decomposed_vector&  that) = delete;
+  decomposed_vector&               operator=    (      decomposed_vector&& temp) = default;
+
+  // Element access (global positions, in local blocks).
+
+  constexpr reference              at           (const multi_size_type& position)
+  {
+    auto [block, local] = locate(position);
+    return (*block)(local);
+  }
+  constexpr const_reference        at           (const multi_size_type& position) const
+  {
+    auto [block, local] = const_cast<decomposed_vector*>(this)->locate(position);
+    return (*block)(local);
+  }
+  template <typename... _positions>
+  constexpr reference              at           (_positions...          position)
+  {
+    return at(multi_size_type {static_cast<size_type>(position)...});
+  }
+  template <typename... _positions>
+  constexpr const_reference        at           (_positions...          position) const
+  {
+    return at(multi_size_type {static_cast<size_type>(position)...});
+  }
+
+  // Block access.
+
+  constexpr size_type              block_count  () const noexcept
+  {
+    size_type result = 1;
+    for (const auto extent : grid_)
+      result *= extent;
+    return result;
+  }
+  constexpr bool                   local        (size_type index) const noexcept
+  {
+    return blocks_[index] != nullptr;
+  }
+  constexpr block_type&            block        (size_type index)
+  {
+    return *blocks_[index];
+  }
+  constexpr const block_type&      block        (size_type index) const
+  {
+    return *blocks_[index];
+  }
+  constexpr multi_size_type        block_coordinates(size_type index) const noexcept
+  {
+    multi_size_type result;
+    for (size_type i = _dimensions; i-- > 0;)
+    {
+      result[i] = index % grid_[i];
+      index    /= grid_[i];
+    }
+    return result;
+  }
+  constexpr size_type              block_index  (const multi_size_type& coordinates) const noexcept
+  {
+    size_type result = 0;
+    for (size_type i = 0; i < _dimensions; ++i)
+      result = result * grid_[i] + coordinates[i];
+    return result;
+  }
+
+  // Calls function(block) for each local block.
+  template <typename _function, typename _execution_policy = const execution::sequenced_policy&>
+  void                             for_each_block(_function&& function, _execution_policy&& policy = execution::seq)
+  {
+    const auto indices = local_indices();
+    for_each_index(policy, indices.size(), [&] (const size_type i)
+    {
+      function(*blocks_[indices[i]]);
+    });
+  }
+
+  // Halo exchange.
+
+  // Packs the boundary layers of the local interiors and sends them to their neighbours.
+  template <typename _execution_policy = const execution::sequenced_policy&>
+  void                             begin_exchange(_execution_policy&& policy = execution::seq)
+  {
+    for_each_direction(policy, [&] (block_type& source, const size_type direction, const size_type target)
+    {
+      const auto                           range = region(source, direction, false);
+      typename transport_type::buffer_type buffer;
+      buffer.reserve(range.size());
+      nested_for(range.begin, range.end, [&] (const multi_size_type& position)
+      {
+        buffer.push_back(source.data(position));
+      });
+      transport_->send(block_index(source.coordinates), target, direction, std::move(buffer));
+    });
+  }
+  // Receives the messages of the neighbours and unpacks them into the halos of the local blocks.
+  template <typename _execution_policy = const execution::sequenced_policy&>
+  void                             end_exchange (_execution_policy&& policy = execution::seq)
+  {
+    for_each_direction(policy, [&] (block_type& target, const size_type direction, const size_type source)
+    {
+      // The neighbour in this direction sent in the opposite direction.
+      const auto buffer = transport_->receive(block_index(target.coordinates), source, direction_count - 1 - direction);
+      auto       value  = buffer.begin();
+      const auto range  = region(target, direction, true);
+      nested_for(range.begin, range.end, [&] (const multi_size_type& position)
+      {
+        target.data(position) = *value++;
+      });
+    });
+  }
+  template <typename _execution_policy = const execution::sequenced_policy&>
+  void                             exchange_halos(_execution_policy&& policy = execution::seq)
+  {
+    begin_exchange(policy);
+    end_exchange  (policy);
+  }
+
+  // Gathers the interiors of the local blocks into a global vector.
+  vector_type                      gather       () const
+  {
+    vector_type result;
+    if constexpr (_dimensions == 1)
+      result = vector_type(dimensions_[0], value_type());
+    else
+      result = vector_type(dimensions_, value_type());
+
+    for (const auto& block : blocks_)
+      if (block)
+        nested_for(block->extent, [&] (const multi_size_type& position)
+        {
+          multi_size_type global;
+          for (size_type i = 0; i < _dimensions; ++i)
+            global[i] = block->origin[i] + position[i];
+          result(global) = (*block)(position);
+        });
+    return result;
+  }
+
+  // Capacity.
+
+  constexpr multi_size_type        dimensions   () const noexcept
+  {
+    return dimensions_;
+  }
+  constexpr multi_size_type        grid         () const noexcept
+  {
+    return grid_;
+  }
+  constexpr size_type              halo         () const noexcept
+  {
+    return halo_;
+  }
+  constexpr transport_type&        transport    () const noexcept
+  {
+    return *transport_;
+  }
+
+protected:
+  std::vector<size_type>           local_indices() const
+  {
+    std::vector<size_type> result;
+    for (size_type i = 0; i < blocks_.size(); ++i)
+      if (blocks_[i])
+        result.push_back(i);
+    return result;
+  }
+
+  // Calls function(block, direction, neighbour) for each local block and each existing neighbour. Directions encode
+  // an offset of -1, 0 or 1 per axis in base 3, the first axis being the most significant digit.
+  template <typename _execution_policy, typename _function>
+  void                             for_each_direction(_execution_policy&& policy, _function&& function)
+  {
+    const auto indices = local_indices();
+    for_each_index(policy, indices.size() * direction_count, [&] (const size_type i)
+    {
+      auto&      block     = *blocks_[indices[i / direction_count]];
+      const auto direction = i % direction_count;
+      if (direction == direction_count / 2)
+        return;
+
+      multi_size_type neighbour;
+      auto            remainder = direction;
+      for (size_type d = _dimensions; d-- > 0;)
+      {
+        const auto offset = static_cast<std::ptrdiff_t>(remainder % 3) - 1;
+        remainder /= 3;
+        if ((offset < 0 && block.coordinates[d] == 0) || (offset > 0 && block.coordinates[d] + 1 == grid_[d]))
+          return;
+        neighbour[d] = block.coordinates[d] + offset;
+      }
+      function(block, direction, block_index(neighbour));
+    });
+  }
+
+  // The boundary layer of the interior facing the direction, or the halo in that direction, in storage positions.
+  box<_dimensions>                 region       (const block_type& block, size_type direction, bool halo) const noexcept
+  {
+    box<_dimensions> result;
+    for (size_type d = _dimensions; d-- > 0;)
+    {
+      const auto digit = direction % 3;
+      direction /= 3;
+      if (digit == 1)
+      {
+        result.begin[d] = halo_;
+        result.end  [d] = halo_ + block.extent[d];
+      }
+      else if (digit == 0)
+      {
+        result.begin[d] = halo ? 0 : halo_;
+        result.end  [d] = result.begin[d] + halo_;
+      }
+      else
+      {
+        result.begin[d] = halo ? halo_ + block.extent[d] : block.extent[d];
+        result.end  [d] = result.begin[d] + halo_;
+      }
+    }
+    return result;
+  }
+  std::pair<block_type*, multi_size_type> locate(const multi_size_type& position)
+  {
+    multi_size_type coordinates;
+    for (size_type i = 0; i < _dimensions; ++i)
+    {
+      if (position[i] >= dimensions_[i])
+        throw std::out_of_range("multi::decomposed_vector::at");
+
+      // Inverse of partition_range: the first remainder partitions hold one more element.
+      const auto quotient  = dimensions_[i] / grid_[i];
+      const auto remainder = dimensions_[i] % grid_[i];
+      const auto boundary  = remainder * (quotient + 1);
+      coordinates[i] = position[i] < boundary ? position[i] / (quotient + 1) : remainder + (position[i] - boundary) / quotient;
+    }
+
+    auto& block = blocks_[block_index(coordinates)];
+    if (!block)
+      throw std::out_of_range("multi::decomposed_vector::at");
+
+    multi_size_type local;
+    for (size_type i = 0; i < _dimensions; ++i)
+      local[i] = position[i] - block->origin[i];
+    return {block.get(), local};
+  }
+
+  multi_size_type                          dimensions_     ;
+  multi_size_type                          grid_           ;
+  size_type                                halo_           ;
+  transport_type*                          transport_      ;
+  std::unique_ptr<transport_type>          owned_transport_;
+  std::vector<std::unique_ptr<block_type>> blocks_         ;
+};
+}
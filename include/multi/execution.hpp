@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace multi
+{
+namespace execution
+{
+struct sequenced_policy
+{
+
+};
+struct parallel_policy
+{
+  std::size_t thread_count = 0; // Zero selects std::thread::hardware_concurrency.
+};
+
+inline constexpr sequenced_policy seq {};
+inline constexpr parallel_policy  par {};
+}
+
+constexpr std::size_t                         concurrency    (const execution::sequenced_policy&       ) noexcept
+{
+  return 1;
+}
+inline    std::size_t                         concurrency    (const execution::parallel_policy&  policy) noexcept
+{
+  return policy.thread_count != 0 ? policy.thread_count : std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+// Returns the [begin, end) range of the index-th of count contiguous, balanced partitions of [0, size).
+constexpr std::pair<std::size_t, std::size_t> partition_range(std::size_t size, std::size_t count, std::size_t index) noexcept
+{
+  const auto quotient  = size / count;
+  const auto remainder = size % count;
+  const auto begin     = index * quotient + std::min(index, remainder);
+  return {begin, begin + quotient + (index < remainder ? 1 : 0)};
+}
+
+template <typename _function>
+void for_each_index(const execution::sequenced_policy&       , std::size_t size, _function&& function)
+{
+  for (std::size_t i = 0; i < size; ++i)
+    function(i);
+}
+// Partition p of partition_range(size, min(concurrency(policy), size), p) is processed by a single thread: partition 0 by
+// the calling thread, the others by threads started for the call. Threads are not pinned nor reused across calls.
+template <typename _function>
+void for_each_index(const execution::parallel_policy&  policy, std::size_t size, _function&& function)
+{
+  const auto count = std::min(concurrency(policy), size);
+  if (count <= 1)
+  {
+    for_each_index(execution::seq, size, function);
+    return;
+  }
+
+  std::vector<std::exception_ptr> exceptions(count);
+  const auto task = [&] (const std::size_t partition)
+  {
+    try
+    {
+      const auto [begin, end] = partition_range(size, count, partition);
+      for (auto i = begin; i < end; ++i)
+        function(i);
+    }
+    catch (...)
+    {
+      exceptions[partition] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(count - 1);
+  for (std::size_t partition = 1; partition < count; ++partition)
+    threads.emplace_back(task, partition);
+  task(0);
+  for (auto& thread : threads)
+    thread.join();
+
+  for (auto& exception : exceptions)
+    if (exception)
+      std::rethrow_exception(exception);
+}
+}
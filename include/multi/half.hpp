@@ -0,0 +1,142 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace multi
+{
+// IEEE 754 binary16 storage. Conversions round to nearest even.
+struct float16
+{
+  constexpr          float16() noexcept = default;
+  constexpr explicit float16(float value) noexcept
+  : bits(from_float(value))
+  {
+
+  }
+
+  constexpr explicit operator float() const noexcept
+  {
+    return to_float(bits);
+  }
+
+  static constexpr std::uint16_t from_float(float value) noexcept
+  {
+    const auto          input    = std::bit_cast<std::uint32_t>(value);
+    const std::uint32_t sign     = (input >> 16) & 0x8000u;
+    const std::uint32_t absolute = input & 0x7FFFFFFFu;
+
+    if (absolute >= 0x7F800000u) // Infinity and NaN (quieted).
+      return static_cast<std::uint16_t>(sign | 0x7C00u | (absolute > 0x7F800000u ? 0x0200u | ((absolute >> 13) & 0x03FFu) : 0u));
+    if (absolute >= 0x477FF000u) // Rounds to infinity.
+      return static_cast<std::uint16_t>(sign | 0x7C00u);
+    if (absolute <  0x38800000u) // Subnormal.
+    {
+      if (absolute < 0x33000000u)
+        return static_cast<std::uint16_t>(sign);
+
+      const std::uint32_t shift     = 126u - (absolute >> 23);
+      const std::uint32_t mantissa  = (absolute & 0x007FFFFFu) | 0x00800000u;
+      const std::uint32_t result    = mantissa >> shift;
+      const std::uint32_t remainder = mantissa & ((1u << shift) - 1u);
+      const std::uint32_t halfway   = 1u << (shift - 1u);
+      return static_cast<std::uint16_t>(sign | (result + (remainder > halfway || (remainder == halfway && (result & 1u)))));
+    }
+
+    const std::uint32_t result    = (absolute - 0x38000000u) >> 13;
+    const std::uint32_t remainder = absolute & 0x1FFFu;
+    return static_cast<std::uint16_t>(sign | (result + (remainder > 0x1000u || (remainder == 0x1000u && (result & 1u)))));
+  }
+  static constexpr float         to_float  (std::uint16_t value) noexcept
+  {
+    const std::uint32_t sign     = static_cast<std::uint32_t>(value & 0x8000u) << 16;
+    const std::uint32_t exponent = (value >> 10) & 0x1Fu;
+    std::uint32_t       mantissa = value & 0x03FFu;
+
+    if (exponent == 0x1Fu)
+      return std::bit_cast<float>(sign | 0x7F800000u | (mantissa << 13));
+    if (exponent != 0u)
+      return std::bit_cast<float>(sign | ((exponent + 112u) << 23) | (mantissa << 13));
+    if (mantissa == 0u)
+      return std::bit_cast<float>(sign);
+
+    std::uint32_t shift = 0;
+    while (!(mantissa & 0x0400u))
+    {
+      mantissa <<= 1;
+      ++shift;
+    }
+    return std::bit_cast<float>(sign | ((113u - shift) << 23) | ((mantissa & 0x03FFu) << 13));
+  }
+
+  std::uint16_t bits = 0;
+};
+
+// Upper half of IEEE 754 binary32. Conversions round to nearest even.
+struct bfloat16
+{
+  constexpr          bfloat16() noexcept = default;
+  constexpr explicit bfloat16(float value) noexcept
+  : bits(from_float(value))
+  {
+
+  }
+
+  constexpr explicit operator float() const noexcept
+  {
+    return to_float(bits);
+  }
+
+  static constexpr std::uint16_t from_float(float value) noexcept
+  {
+    const auto input = std::bit_cast<std::uint32_t>(value);
+    if ((input & 0x7FFFFFFFu) > 0x7F800000u) // NaN (quieted).
+      return static_cast<std::uint16_t>((input >> 16) | 0x0040u);
+    return static_cast<std::uint16_t>((input + 0x7FFFu + ((input >> 16) & 1u)) >> 16);
+  }
+  static constexpr float         to_float  (std::uint16_t value) noexcept
+  {
+    return std::bit_cast<float>(static_cast<std::uint32_t>(value) << 16);
+  }
+
+  std::uint16_t bits = 0;
+};
+
+static_assert(sizeof(float16) == 2 && sizeof(bfloat16) == 2);
+
+// Bulk conversions. The float16 ones use F16C when the target supports it.
+
+inline void convert(const float*    first, const float*    last, float16*  output) noexcept
+{
+#if defined(__F16C__)
+  for (; last - first >= 8; first += 8, output += 8)
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm256_cvtps_ph(_mm256_loadu_ps(first), _MM_FROUND_TO_NEAREST_INT));
+#endif
+  for (; first != last; ++first, ++output)
+    output->bits = float16::from_float(*first);
+}
+inline void convert(const float16*  first, const float16*  last, float*    output) noexcept
+{
+#if defined(__F16C__)
+  for (; last - first >= 8; first += 8, output += 8)
+    _mm256_storeu_ps(output, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first))));
+#endif
+  for (; first != last; ++first, ++output)
+    *output = float16::to_float(first->bits);
+}
+inline void convert(const float*    first, const float*    last, bfloat16* output) noexcept
+{
+  for (; first != last; ++first, ++output)
+    output->bits = bfloat16::from_float(*first);
+}
+inline void convert(const bfloat16* first, const bfloat16* last, float*    output) noexcept
+{
+  for (; first != last; ++first, ++output)
+    *output = bfloat16::to_float(first->bits);
+}
+}
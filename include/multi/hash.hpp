@@ -0,0 +1,288 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include <multi/array.hpp>
+#include <multi/execution.hpp>
+#include <multi/ndindex.hpp>
+#include <multi/simd.hpp>
+#include <multi/vector.hpp>
+
+// Content hashing in the manner of XXH3: 64-byte stripes are folded into eight 64-bit accumulators by 32x32-bit
+// multiplications, which map to SIMD registers of any width, so that the hash is the same for every instruction set.
+// Storage is hashed in fixed chunks which are processed concurrently, so that it does not depend on the policy either.
+// The hashes are not stable across library versions and are not cryptographic.
+namespace multi
+{
+namespace detail
+{
+inline constexpr std::size_t hash_chunk_size = std::size_t(1) << 20; // Bytes.
+
+inline constexpr std::uint64_t hash_prime32_1 = 0x9E3779B1ull;
+inline constexpr std::uint64_t hash_prime64_1 = 0x9E3779B185EBCA87ull;
+inline constexpr std::uint64_t hash_prime64_2 = 0xC2B2AE3D27D4EB4Full;
+inline constexpr std::uint64_t hash_prime64_3 = 0x165667B19E3779F9ull;
+
+inline constexpr std::array<std::uint64_t, 16> hash_secret
+{
+  0xBE4BA423396CFEB8ull, 0x1CAD21F72C81017Cull, 0xDB979083E96DD4DEull, 0x1F67B3B7A4A44072ull,
+  0x78E5C0CC4EE679CBull, 0x2172FFCC7DD05A82ull, 0x8E2443F7744608B8ull, 0x4C263A81E69035E0ull,
+  0xCB00C391BB52283Cull, 0xA32E531B8B65D088ull, 0x4EF90DA297486471ull, 0xD8ACDEA946EF1938ull,
+  0x3F349CE33F76FAA8ull, 0x1D4F0BC7C7BBDCF9ull, 0x3159B4CD4BE0518Aull, 0x647378D9C97E9FC8ull
+};
+inline constexpr std::size_t hash_stripe_size       = 64; // Bytes.
+inline constexpr std::size_t hash_stripes_per_block = 8 ;
+
+constexpr std::uint64_t hash_avalanche(std::uint64_t value) noexcept
+{
+  value ^= value >> 37;
+  value *= 0x165667919E3779F9ull;
+  return value ^ (value >> 32);
+}
+constexpr std::uint64_t hash_fold     (std::uint64_t lhs, std::uint64_t rhs) noexcept
+{
+  // The 128-bit product, folded to 64 bits.
+#if defined(__SIZEOF_INT128__)
+  const auto product = static_cast<unsigned __int128>(lhs) * rhs;
+  return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+  const std::uint64_t lhs_low  = lhs & 0xFFFFFFFFull, lhs_high  = lhs >> 32;
+  const std::uint64_t rhs_low  = rhs & 0xFFFFFFFFull, rhs_high  = rhs >> 32;
+  const std::uint64_t low_low  = lhs_low * rhs_low  , high_low  = lhs_high * rhs_low ;
+  const std::uint64_t low_high = lhs_low * rhs_high , high_high = lhs_high * rhs_high;
+  const std::uint64_t middle   = (low_low >> 32) + (high_low & 0xFFFFFFFFull) + low_high;
+  const std::uint64_t low      = (middle << 32) | (low_low & 0xFFFFFFFFull);
+  const std::uint64_t high     = high_high + (high_low >> 32) + (middle >> 32);
+  return low ^ high;
+#endif
+}
+
+inline constexpr std::size_t hash_lanes = hash_stripe_size / sizeof(std::uint64_t);
+using hash_lanes_type = std::array<std::uint64_t, hash_lanes>;
+
+constexpr hash_lanes_type hash_start (std::uint64_t seed) noexcept
+{
+  hash_lanes_type result;
+  for (std::size_t i = 0; i < hash_lanes; ++i)
+    result[i] = hash_secret[i] ^ (seed * hash_prime64_1);
+  return result;
+}
+constexpr std::uint64_t   hash_finish(const hash_lanes_type& accumulators, std::size_t length, std::uint64_t seed) noexcept
+{
+  std::uint64_t result = length * hash_prime64_1 + seed;
+  for (std::size_t i = 0; i < hash_lanes; i += 2)
+    result += hash_fold(accumulators[i] ^ hash_secret[i], accumulators[i + 1] ^ hash_secret[i + 1] ^ hash_prime64_2);
+  return hash_avalanche(result ^ hash_prime64_3);
+}
+
+// Hashes the object representations of the elements, except that floating-point zeros hash alike so that equal
+// elements hash equally.
+template <typename _type>
+std::uint64_t hash_elements(const _type* data, std::size_t size, std::uint64_t seed)
+{
+  static_assert(std::has_unique_object_representations_v<_type> || std::is_same_v<_type, float> || std::is_same_v<_type, double>, "The elements must be hashable by their object representations.");
+
+  const auto bytes  = reinterpret_cast<const unsigned char*>(data);
+  const auto length = size * sizeof(_type);
+#if defined(__GNUC__)
+  return simd::detail::dispatch([&] <std::size_t _bytes> () __attribute__((always_inline))
+  {
+    // The scalar path processes single-lane vectors.
+    constexpr auto width      = _bytes != 0 ? _bytes : sizeof(std::uint64_t);
+    constexpr auto lanes      = width / sizeof(std::uint64_t);
+    constexpr auto registers  = hash_stripe_size / width;
+    using vector              = simd::detail::vector_type<std::uint64_t, width>;
+
+    vector accumulators[registers]; // Not a std::array, which would drop the vector attribute.
+    const auto start = hash_start(seed);
+    std::memcpy(accumulators, start.data(), hash_stripe_size);
+
+    const auto accumulate = [&] (const unsigned char* stripe, std::size_t index) __attribute__((always_inline))
+    {
+      for (std::size_t r = 0; r < registers; ++r)
+      {
+        vector value, key;
+        if constexpr (std::is_floating_point_v<_type>)
+        {
+          // Adding zero turns negative zeros positive.
+          simd::detail::vector_type<_type, width> element;
+          std::memcpy(&element, stripe + r * width, width);
+          element = element + _type(0);
+          std::memcpy(&value, &element, width);
+        }
+        else
+          std::memcpy(&value, stripe + r * width, width);
+        std::memcpy(&key, hash_secret.data() + index + r * lanes, width);
+
+        const vector mixed = value ^ key;
+        accumulators[r] += ((value << 32) | (value >> 32)) + (mixed & 0xFFFFFFFFull) * (mixed >> 32);
+      }
+    };
+    const auto scramble   = [&] () __attribute__((always_inline))
+    {
+      for (std::size_t r = 0; r < registers; ++r)
+      {
+        vector key;
+        std::memcpy(&key, hash_secret.data() + hash_stripes_per_block + r * lanes, width);
+        accumulators[r] = (accumulators[r] ^ (accumulators[r] >> 47) ^ key) * hash_prime32_1;
+      }
+    };
+
+    std::size_t offset = 0, stripe = 0;
+    for (; offset + hash_stripe_size <= length; offset += hash_stripe_size)
+    {
+      accumulate(bytes + offset, stripe);
+      if (++stripe == hash_stripes_per_block)
+      {
+        scramble();
+        stripe = 0;
+      }
+    }
+    if (offset < length)
+    {
+      alignas(hash_stripe_size) std::array<unsigned char, hash_stripe_size> last {};
+      std::memcpy(last.data(), bytes + offset, length - offset);
+      accumulate(last.data(), stripe);
+    }
+
+    hash_lanes_type result;
+    std::memcpy(result.data(), accumulators, hash_stripe_size);
+    return hash_finish(result, length, seed);
+  });
+#else
+  // The kernel above over scalar lanes, which hashes alike.
+  auto accumulators = hash_start(seed);
+
+  const auto accumulate = [&] (const unsigned char* stripe, std::size_t index)
+  {
+    for (std::size_t j = 0; j < hash_lanes; ++j)
+    {
+      std::uint64_t value;
+      if constexpr (std::is_floating_point_v<_type>)
+      {
+        // Adding zero turns negative zeros positive.
+        _type elements[sizeof(std::uint64_t) / sizeof(_type)];
+        std::memcpy(elements, stripe + j * sizeof(std::uint64_t), sizeof(std::uint64_t));
+        for (auto& element : elements)
+          element = element + _type(0);
+        std::memcpy(&value, elements, sizeof(std::uint64_t));
+      }
+      else
+        std::memcpy(&value, stripe + j * sizeof(std::uint64_t), sizeof(std::uint64_t));
+
+      const auto mixed = value ^ hash_secret[index + j];
+      accumulators[j] += ((value << 32) | (value >> 32)) + (mixed & 0xFFFFFFFFull) * (mixed >> 32);
+    }
+  };
+  const auto scramble   = [&] ()
+  {
+    for (std::size_t j = 0; j < hash_lanes; ++j)
+      accumulators[j] = (accumulators[j] ^ (accumulators[j] >> 47) ^ hash_secret[hash_stripes_per_block + j]) * hash_prime32_1;
+  };
+
+  std::size_t offset = 0, stripe = 0;
+  for (; offset + hash_stripe_size <= length; offset += hash_stripe_size)
+  {
+    accumulate(bytes + offset, stripe);
+    if (++stripe == hash_stripes_per_block)
+    {
+      scramble();
+      stripe = 0;
+    }
+  }
+  if (offset < length)
+  {
+    std::array<unsigned char, hash_stripe_size> last {};
+    std::memcpy(last.data(), bytes + offset, length - offset);
+    accumulate(last.data(), stripe);
+  }
+  return hash_finish(accumulators, length, seed);
+#endif
+}
+}
+
+// Hash of the storage of a container or view together with its extents and strides, i.e. its shape and layout.
+// Containers with equal elements, extents and strides hash equally. Contiguous storage is hashed in memory order, and
+// the elements of other strided spans (e.g. views of a sub-range) in layout_right order of their positions. Chunks of
+// the elements are hashed concurrently.
+template <typename _container, typename _execution_policy = const execution::sequenced_policy&>
+std::uint64_t content_hash(const _container& container, _execution_policy&& policy = execution::seq)
+{
+  using element_type = std::remove_cvref_t<decltype(*container.data())>;
+  using span_type    = std::remove_cvref_t<decltype(container.span())>;
+
+  constexpr auto rank       = span_type::rank();
+  const auto     span       = container.span();
+  const auto     size       = static_cast<std::size_t>(span.size());
+  const auto     chunk_size = std::max<std::size_t>(detail::hash_chunk_size / sizeof(element_type), 1);
+  const auto     chunks     = (size + chunk_size - 1) / chunk_size;
+
+  // The rank, the extents and the strides, followed by the hashes of the chunks.
+  std::vector<std::uint64_t> words(1 + 2 * rank + chunks);
+  words[0] = rank;
+  for (std::size_t i = 0; i < rank; ++i)
+  {
+    words[1 + i       ] = span.extent(i);
+    words[1 + rank + i] = static_cast<std::uint64_t>(span.stride(i));
+  }
+  if (span.is_contiguous())
+  {
+    for_each_index(policy, chunks, [&] (const std::size_t chunk)
+    {
+      const auto begin = chunk * chunk_size;
+      const auto end   = std::min(begin + chunk_size, size);
+      words[1 + 2 * rank + chunk] = detail::hash_elements(container.data() + begin, end - begin, chunk);
+    });
+  }
+  else
+  {
+    std::array<std::size_t   , rank> extents;
+    std::array<std::size_t   , rank> order  ;
+    std::array<std::ptrdiff_t, rank> strides;
+    for (std::size_t i = 0; i < rank; ++i)
+    {
+      extents[i] = span.extent(i);
+      order  [i] = rank - 1 - i;
+      strides[i] = static_cast<std::ptrdiff_t>(span.stride(i));
+    }
+    const ndindex_range<rank> positions(extents, order, strides);
+    for_each_index(policy, chunks, [&] (const std::size_t chunk)
+    {
+      const auto begin = chunk * chunk_size;
+      const auto end   = std::min(begin + chunk_size, size);
+
+      std::vector<element_type> elements(end - begin);
+      auto position = positions.begin() + static_cast<std::ptrdiff_t>(begin);
+      for (auto& element : elements)
+        element = container.data()[(position++).offset()];
+      words[1 + 2 * rank + chunk] = detail::hash_elements(elements.data(), elements.size(), chunk);
+    });
+  }
+  return detail::hash_elements(words.data(), words.size(), sizeof(element_type));
+}
+}
+namespace std
+{
+template <typename _type, std::size_t _dimensions, typename _layout, typename _accessor, typename _allocator, typename _extents>
+struct hash<multi::vector<_type, _dimensions, _layout, _accessor, _allocator, _extents>>
+{
+  std::size_t operator()(const multi::vector<_type, _dimensions, _layout, _accessor, _allocator, _extents>& container) const
+  {
+    return static_cast<std::size_t>(multi::content_hash(container));
+  }
+};
+template <typename _type, typename _dimensions, typename _layout, typename _accessor>
+struct hash<multi::array<_type, _dimensions, _layout, _accessor>>
+{
+  std::size_t operator()(const multi::array<_type, _dimensions, _layout, _accessor>& container) const
+  {
+    return static_cast<std::size_t>(multi::content_hash(container));
+  }
+};
+}
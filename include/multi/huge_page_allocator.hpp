@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace multi
+{
+// Allocator backing allocations of at least one huge page with 2 MiB aligned mappings advised for transparent huge
+// pages. Optionally tries explicit hugetlb pages first, falling back when none are reserved. Smaller allocations, and
+// all allocations on systems without mmap, use the aligned global operator new.
+template <typename _type>
+class huge_page_allocator
+{
+public:
+  using value_type                             = _type;
+  using size_type                              = std::size_t;
+  using difference_type                        = std::ptrdiff_t;
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal                        = std::true_type;
+
+  static constexpr size_type huge_page_size = size_type(1) << 21;
+
+  constexpr          huge_page_allocator() noexcept = default;
+  constexpr explicit huge_page_allocator(bool hugetlb) noexcept
+  : hugetlb_(hugetlb)
+  {
+
+  }
+  template <typename _other>
+  constexpr          huge_page_allocator(const huge_page_allocator<_other>& that) noexcept
+  : hugetlb_(that.hugetlb())
+  {
+
+  }
+
+  _type*                 allocate  (size_type size)
+  {
+    if (size > std::numeric_limits<size_type>::max() / sizeof(_type) - huge_page_size)
+      throw std::bad_array_new_length();
+
+#if defined(__linux__)
+    if (size * sizeof(_type) >= huge_page_size)
+    {
+      const auto bytes = mapped_size(size);
+#if defined(MAP_HUGETLB)
+      if (hugetlb_)
+        if (const auto data = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0); data != MAP_FAILED)
+          return static_cast<_type*>(data);
+#endif
+
+      // Over-map by one huge page and trim both ends to obtain an aligned mapping.
+      const auto data = static_cast<std::byte*>(mmap(nullptr, bytes + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+      if (data == MAP_FAILED)
+        throw std::bad_alloc();
+
+      const auto head    = (huge_page_size - reinterpret_cast<std::uintptr_t>(data) % huge_page_size) % huge_page_size;
+      const auto aligned = data + head;
+      if (head > 0)
+        munmap(data, head);
+      munmap(aligned + bytes, huge_page_size - head);
+#if defined(MADV_HUGEPAGE)
+      madvise(aligned, bytes, MADV_HUGEPAGE);
+#endif
+      return reinterpret_cast<_type*>(aligned);
+    }
+#endif
+    return static_cast<_type*>(::operator new(size * sizeof(_type), std::align_val_t(alignof(_type))));
+  }
+  void                   deallocate(_type* pointer, size_type size) noexcept
+  {
+#if defined(__linux__)
+    if (size * sizeof(_type) >= huge_page_size)
+    {
+      munmap(pointer, mapped_size(size));
+      return;
+    }
+#endif
+    ::operator delete(pointer, std::align_val_t(alignof(_type)));
+  }
+
+  constexpr bool         hugetlb   () const noexcept
+  {
+    return hugetlb_;
+  }
+
+protected:
+  static constexpr size_type mapped_size(size_type size) noexcept
+  {
+    return (size * sizeof(_type) + huge_page_size - 1) / huge_page_size * huge_page_size;
+  }
+
+  bool hugetlb_ = false;
+};
+
+template <typename _lhs, typename _rhs>
+constexpr bool operator==(const huge_page_allocator<_lhs>&, const huge_page_allocator<_rhs>&) noexcept
+{
+  return true;
+}
+}
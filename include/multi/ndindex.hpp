@@ -0,0 +1,378 @@
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <utility>
+
+#include <multi/third_party/mdspan.hpp>
+
+namespace multi
+{
+// Random access iterator over the positions within extents. Increments and decrements step an odometer in the given
+// axis order (fastest first) without divisions; only jumps decompose the linear index. Strided offsets of the positions
+// are maintained alongside, so that a traversal in stride order is memory-sequential.
+template <std::size_t _dimensions>
+class ndindex_iterator
+{
+public:
+  using multi_size_type   = std::array<std::size_t   , _dimensions>;
+  using stride_type       = std::array<std::ptrdiff_t, _dimensions>;
+  using iterator_concept  = std::random_access_iterator_tag;
+  using iterator_category = std::input_iterator_tag;
+  using value_type        = multi_size_type;
+  using difference_type   = std::ptrdiff_t;
+  using reference         = multi_size_type;
+
+  constexpr ndindex_iterator() noexcept = default;
+  constexpr ndindex_iterator(const multi_size_type& extents, const multi_size_type& order, const stride_type& strides, difference_type index) noexcept
+  : extents_(extents), order_(order), strides_(strides)
+  {
+    seek(index);
+  }
+
+  constexpr reference          operator* () const noexcept
+  {
+    return position_;
+  }
+  constexpr reference          operator[](difference_type n) const noexcept
+  {
+    return *(*this + n);
+  }
+
+  constexpr ndindex_iterator&  operator++() noexcept
+  {
+    ++index_;
+    // The slowest axis does not wrap, so that the end position follows the last one.
+    for (std::size_t i = 0; i < _dimensions; ++i)
+    {
+      const auto axis = order_[i];
+      ++position_[axis];
+      offset_ += strides_[axis];
+      if (position_[axis] < extents_[axis] || i + 1 == _dimensions)
+        break;
+      offset_ -= static_cast<std::ptrdiff_t>(extents_[axis]) * strides_[axis];
+      position_[axis] = 0;
+    }
+    return *this;
+  }
+  constexpr ndindex_iterator   operator++(int) noexcept
+  {
+    auto result = *this;
+    ++*this;
+    return result;
+  }
+  constexpr ndindex_iterator&  operator--() noexcept
+  {
+    --index_;
+    for (std::size_t i = 0; i < _dimensions; ++i)
+    {
+      const auto axis = order_[i];
+      if (position_[axis] > 0 || i + 1 == _dimensions)
+      {
+        --position_[axis];
+        offset_ -= strides_[axis];
+        break;
+      }
+      position_[axis] = extents_[axis] - 1;
+      offset_ += static_cast<std::ptrdiff_t>(position_[axis]) * strides_[axis];
+    }
+    return *this;
+  }
+  constexpr ndindex_iterator   operator--(int) noexcept
+  {
+    auto result = *this;
+    --*this;
+    return result;
+  }
+
+  constexpr ndindex_iterator&  operator+=(difference_type n) noexcept
+  {
+    seek(index_ + n);
+    return *this;
+  }
+  constexpr ndindex_iterator&  operator-=(difference_type n) noexcept
+  {
+    seek(index_ - n);
+    return *this;
+  }
+  friend constexpr ndindex_iterator operator+(ndindex_iterator iterator, difference_type n) noexcept
+  {
+    return iterator += n;
+  }
+  friend constexpr ndindex_iterator operator+(difference_type n, ndindex_iterator iterator) noexcept
+  {
+    return iterator += n;
+  }
+  friend constexpr ndindex_iterator operator-(ndindex_iterator iterator, difference_type n) noexcept
+  {
+    return iterator -= n;
+  }
+  friend constexpr difference_type  operator-(const ndindex_iterator& lhs, const ndindex_iterator& rhs) noexcept
+  {
+    return lhs.index_ - rhs.index_;
+  }
+
+  friend constexpr bool                 operator== (const ndindex_iterator& lhs, const ndindex_iterator& rhs) noexcept
+  {
+    return lhs.index_ == rhs.index_;
+  }
+  friend constexpr std::strong_ordering operator<=>(const ndindex_iterator& lhs, const ndindex_iterator& rhs) noexcept
+  {
+    return lhs.index_ <=> rhs.index_;
+  }
+
+  // Linear index in the traversal order.
+  constexpr difference_type    index     () const noexcept
+  {
+    return index_;
+  }
+  // Sum of the position's components weighted by the strides.
+  constexpr std::ptrdiff_t     offset    () const noexcept
+  {
+    return offset_;
+  }
+
+protected:
+  constexpr void               seek      (difference_type index) noexcept
+  {
+    index_  = index;
+    offset_ = 0;
+    auto remainder = static_cast<std::size_t>(index);
+    for (std::size_t i = 0; i < _dimensions; ++i)
+    {
+      const auto axis = order_[i];
+      position_[axis] = i + 1 < _dimensions && extents_[axis] != 0 ? remainder % extents_[axis] : remainder;
+      remainder       = i + 1 < _dimensions && extents_[axis] != 0 ? remainder / extents_[axis] : 0;
+      offset_        += static_cast<std::ptrdiff_t>(position_[axis]) * strides_[axis];
+    }
+  }
+
+  multi_size_type extents_  {};
+  multi_size_type order_    {};
+  stride_type     strides_  {};
+  multi_size_type position_ {};
+  difference_type index_    = 0;
+  std::ptrdiff_t  offset_   = 0;
+};
+
+// Sized random access range of the positions within extents, e.g. for (const auto& [x, y] : coords(dimensions)).
+template <std::size_t _dimensions>
+class ndindex_range : public std::ranges::view_interface<ndindex_range<_dimensions>>
+{
+public:
+  using iterator        = ndindex_iterator<_dimensions>;
+  using multi_size_type = typename iterator::multi_size_type;
+  using stride_type     = typename iterator::stride_type;
+
+  constexpr ndindex_range() noexcept = default;
+  constexpr ndindex_range(const multi_size_type& extents, const multi_size_type& order, const stride_type& strides = {}) noexcept
+  : extents_(extents), order_(order), strides_(strides)
+  {
+
+  }
+
+  constexpr iterator    begin() const noexcept
+  {
+    return iterator(extents_, order_, strides_, 0);
+  }
+  constexpr iterator    end  () const noexcept
+  {
+    return iterator(extents_, order_, strides_, static_cast<std::ptrdiff_t>(size()));
+  }
+  constexpr std::size_t size () const noexcept
+  {
+    std::size_t result = 1;
+    for (const auto extent : extents_)
+      result *= extent;
+    return result;
+  }
+
+protected:
+  multi_size_type extents_ {};
+  multi_size_type order_   {};
+  stride_type     strides_ {};
+};
+
+// Axes by increasing stride of the mapping, i.e. the fastest first. Ties keep the layout_right order.
+template <typename _mapping>
+constexpr std::array<std::size_t, _mapping::extents_type::rank()> stride_order(const _mapping& mapping)
+{
+  static_assert(_mapping::is_always_strided(), "The mapping must be strided.");
+
+  constexpr auto rank = _mapping::extents_type::rank();
+  std::array<std::size_t, rank> result {};
+  for (std::size_t i = 0; i < rank; ++i)
+    result[i] = rank - 1 - i;
+  // Insertion sort, stable over the reversed axes.
+  for (std::size_t i = 1; i < rank; ++i)
+    for (auto j = i; j > 0 && mapping.stride(result[j]) < mapping.stride(result[j - 1]); --j)
+      std::swap(result[j], result[j - 1]);
+  return result;
+}
+
+// Positions within the extents, the last axis fastest.
+template <std::size_t _dimensions>
+constexpr ndindex_range<_dimensions> coords(const std::array<std::size_t, _dimensions>& extents)
+{
+  std::array<std::size_t, _dimensions> order {};
+  for (std::size_t i = 0; i < _dimensions; ++i)
+    order[i] = _dimensions - 1 - i;
+  return ndindex_range<_dimensions>(extents, order);
+}
+// Positions within the extents, in the given axis order (fastest first).
+template <std::size_t _dimensions>
+constexpr ndindex_range<_dimensions> coords(const std::array<std::size_t, _dimensions>& extents, const std::array<std::size_t, _dimensions>& order)
+{
+  return ndindex_range<_dimensions>(extents, order);
+}
+template <std::size_t... _extents>
+constexpr ndindex_range<sizeof...(_extents)> coords(const std::experimental::extents<_extents...>& extents)
+{
+  std::array<std::size_t, sizeof...(_extents)> result {};
+  for (std::size_t i = 0; i < result.size(); ++i)
+    result[i] = extents.extent(i);
+  return coords(result);
+}
+
+// Random access iterator over (reference, position) pairs of a strided span, traversed in stride order.
+template <typename _span, typename _reference = typename _span::reference>
+class indexed_iterator
+{
+public:
+  using position_iterator = ndindex_iterator<_span::rank()>;
+  using multi_size_type   = typename position_iterator::multi_size_type;
+  using iterator_concept  = std::random_access_iterator_tag;
+  using iterator_category = std::input_iterator_tag;
+  using value_type        = std::pair<_reference, multi_size_type>;
+  using difference_type   = std::ptrdiff_t;
+  using reference         = value_type;
+
+  constexpr indexed_iterator() noexcept = default;
+  constexpr indexed_iterator(const _span& span, const position_iterator& position) noexcept
+  : span_(span), position_(position)
+  {
+
+  }
+
+  constexpr reference          operator* () const
+  {
+    return {span_.accessor().access(span_.data(), static_cast<std::size_t>(position_.offset())), *position_};
+  }
+  constexpr reference          operator[](difference_type n) const
+  {
+    return *(*this + n);
+  }
+
+  constexpr indexed_iterator&  operator++() noexcept
+  {
+    ++position_;
+    return *this;
+  }
+  constexpr indexed_iterator   operator++(int) noexcept
+  {
+    auto result = *this;
+    ++position_;
+    return result;
+  }
+  constexpr indexed_iterator&  operator--() noexcept
+  {
+    --position_;
+    return *this;
+  }
+  constexpr indexed_iterator   operator--(int) noexcept
+  {
+    auto result = *this;
+    --position_;
+    return result;
+  }
+
+  constexpr indexed_iterator&  operator+=(difference_type n) noexcept
+  {
+    position_ += n;
+    return *this;
+  }
+  constexpr indexed_iterator&  operator-=(difference_type n) noexcept
+  {
+    position_ -= n;
+    return *this;
+  }
+  friend constexpr indexed_iterator operator+(indexed_iterator iterator, difference_type n) noexcept
+  {
+    return iterator += n;
+  }
+  friend constexpr indexed_iterator operator+(difference_type n, indexed_iterator iterator) noexcept
+  {
+    return iterator += n;
+  }
+  friend constexpr indexed_iterator operator-(indexed_iterator iterator, difference_type n) noexcept
+  {
+    return iterator -= n;
+  }
+  friend constexpr difference_type  operator-(const indexed_iterator& lhs, const indexed_iterator& rhs) noexcept
+  {
+    return lhs.position_ - rhs.position_;
+  }
+
+  friend constexpr bool                 operator== (const indexed_iterator& lhs, const indexed_iterator& rhs) noexcept
+  {
+    return lhs.position_ == rhs.position_;
+  }
+  friend constexpr std::strong_ordering operator<=>(const indexed_iterator& lhs, const indexed_iterator& rhs) noexcept
+  {
+    return lhs.position_ <=> rhs.position_;
+  }
+
+protected:
+  _span             span_    ;
+  position_iterator position_;
+};
+
+template <typename _span, typename _reference = typename _span::reference>
+class indexed_range : public std::ranges::view_interface<indexed_range<_span, _reference>>
+{
+public:
+  using iterator        = indexed_iterator<_span, _reference>;
+  using multi_size_type = typename iterator::multi_size_type;
+
+  constexpr indexed_range() noexcept = default;
+  constexpr explicit indexed_range(const _span& span)
+  : span_(span)
+  {
+    multi_size_type                                       extents;
+    typename ndindex_iterator<_span::rank()>::stride_type strides;
+    for (std::size_t i = 0; i < _span::rank(); ++i)
+    {
+      extents[i] = span.extent(i);
+      strides[i] = static_cast<std::ptrdiff_t>(span.stride(i));
+    }
+    positions_ = ndindex_range<_span::rank()>(extents, stride_order(span.mapping()), strides);
+  }
+
+  constexpr iterator    begin() const noexcept
+  {
+    return iterator(span_, positions_.begin());
+  }
+  constexpr iterator    end  () const noexcept
+  {
+    return iterator(span_, positions_.end());
+  }
+  constexpr std::size_t size () const noexcept
+  {
+    return positions_.size();
+  }
+
+protected:
+  _span                        span_     ;
+  ndindex_range<_span::rank()> positions_;
+};
+
+// (reference, position) pairs of the span's elements, in memory order for strided layouts.
+template <typename _span>
+constexpr indexed_range<_span> indexed(const _span& span)
+{
+  return indexed_range<_span>(span);
+}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <multi/third_party/mdspan.hpp>
+
+namespace multi
+{
+namespace detail
+{
+// Axis of the loop at the level, counted from the outermost. layout_left nests its first axis innermost, every other
+// layout its last one.
+template <typename _layout, std::size_t _dimensions, std::size_t _level>
+constexpr std::size_t nested_axis() noexcept
+{
+  if constexpr (std::is_same_v<_layout, std::experimental::layout_left>)
+    return _dimensions - 1 - _level;
+  else
+    return _level;
+}
+
+template <typename _function, std::size_t _dimensions, std::size_t... _axes>
+constexpr void        nested_call(_function& function, const std::array<std::size_t, _dimensions>& position, std::index_sequence<_axes...>)
+{
+  if constexpr (std::is_invocable_v<_function&, decltype(position[_axes])...>)
+    function(position[_axes]...);
+  else
+    function(position);
+}
+
+template <typename _layout, std::size_t _level, std::size_t _dimensions, typename _function>
+constexpr void        nested_loop(const std::array<std::size_t, _dimensions>& begin, const std::array<std::size_t, _dimensions>& end, std::array<std::size_t, _dimensions>& position, _function& function)
+{
+  if constexpr (_level == _dimensions)
+    nested_call(function, static_cast<const std::array<std::size_t, _dimensions>&>(position), std::make_index_sequence<_dimensions>());
+  else
+  {
+    constexpr auto axis = nested_axis<_layout, _dimensions, _level>();
+    for (position[axis] = begin[axis]; position[axis] < end[axis]; ++position[axis])
+      nested_loop<_layout, _level + 1>(begin, end, position, function);
+  }
+}
+}
+
+// Calls function(i0, ..., iN-1), or function(position) if it does not take the indices separately, for each position in
+// [begin, end). Expands into N plain nested loops, the innermost over the contiguous axis of the layout, so that it
+// compiles as hand-written loops would.
+template <std::size_t _dimensions, typename _layout = std::experimental::layout_right, typename _function>
+constexpr void nested_for(const std::array<std::size_t, _dimensions>& begin, const std::array<std::size_t, _dimensions>& end, _function&& function)
+{
+  std::array<std::size_t, _dimensions> position {};
+  detail::nested_loop<_layout, 0>(begin, end, position, function);
+}
+template <std::size_t _dimensions, typename _layout = std::experimental::layout_right, typename _function>
+constexpr void nested_for(const std::array<std::size_t, _dimensions>& extents, _function&& function)
+{
+  nested_for<_dimensions, _layout>(std::array<std::size_t, _dimensions> {}, extents, function);
+}
+}
@@ -0,0 +1,308 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <cstdlib>
+#endif
+
+#include <multi/execution.hpp>
+#include <multi/vector.hpp>
+
+namespace multi::numa
+{
+enum class placement
+{
+  local      , // Pages are placed where the constructing thread first touches them.
+  first_touch, // Pages are split into contiguous ranges, one per memory node in order, each placed on its node.
+  interleaved  // Pages are interleaved round-robin across all nodes.
+};
+
+// Number of configured memory nodes. One on systems without NUMA support.
+inline std::size_t node_count()
+{
+#if defined(__linux__)
+  static const std::size_t result = []
+  {
+    std::ifstream stream("/sys/devices/system/node/possible");
+    std::string   line;
+    if (!std::getline(stream, line) || line.empty())
+      return std::size_t(1);
+
+    const auto position = line.find_last_of("-,");
+    return static_cast<std::size_t>(std::stoul(position == std::string::npos ? line : line.substr(position + 1))) + 1;
+  }();
+  return result;
+#else
+  return 1;
+#endif
+}
+
+namespace detail
+{
+// Reads a kernel list of ranges, e.g. "0-3,8,10-11". Empty if it cannot be read.
+inline std::vector<std::size_t> read_list(const std::string& path)
+{
+  std::vector<std::size_t> result;
+  std::ifstream            stream(path);
+  std::string              range;
+  while (std::getline(stream, range, ','))
+  {
+    if (range.empty() || range == "\n")
+      continue;
+    const auto dash  = range.find('-');
+    const auto first = static_cast<std::size_t>(std::stoul(range.substr(0, dash)));
+    const auto last  = dash == std::string::npos ? first : static_cast<std::size_t>(std::stoul(range.substr(dash + 1)));
+    for (auto i = first; i <= last; ++i)
+      result.push_back(i);
+  }
+  return result;
+}
+}
+
+// Nodes which have memory, in ascending order. Node 0 on systems without NUMA support.
+inline const std::vector<std::size_t>& memory_nodes()
+{
+  static const std::vector<std::size_t> result = []
+  {
+#if defined(__linux__)
+    auto nodes = detail::read_list("/sys/devices/system/node/has_memory");
+    if (!nodes.empty())
+      return nodes;
+#endif
+    return std::vector<std::size_t> {0};
+  }();
+  return result;
+}
+
+inline std::size_t page_size()
+{
+#if defined(__linux__)
+  static const std::size_t result = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  return result;
+#else
+  return 4096;
+#endif
+}
+
+#if defined(__linux__)
+namespace detail
+{
+// Sets the memory policy of the pages over the nodes. Returns false on failure.
+inline bool bind(void* data, std::size_t bytes, int mode, const std::vector<std::size_t>& nodes)
+{
+  std::vector<unsigned long> mask((node_count() + 63) / 64, 0ul);
+  for (const auto node : nodes)
+    mask[node / 64] |= 1ul << (node % 64);
+  return syscall(SYS_mbind, data, bytes, mode, mask.data(), mask.size() * 64 + 1, 0) == 0;
+}
+// Pins the calling thread to the CPUs of the node. Returns false on failure, e.g. for nodes without CPUs.
+inline bool pin(std::size_t node)
+{
+  const auto cpus = read_list("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+  cpu_set_t  set;
+  CPU_ZERO(&set);
+  for (const auto cpu : cpus)
+    if (cpu < CPU_SETSIZE)
+      CPU_SET(cpu, &set);
+  return !cpus.empty() && sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+}
+#endif
+
+// Page-granular allocator applying a placement to each allocation. Intended for large buffers: every allocation is
+// mapped separately. With first_touch, range n of partition_range(pages, memory_nodes().size(), n) is bound
+// preferentially to the n-th memory node and touched by a thread pinned to that node, so that it resides there whichever
+// threads run later; outer_ranges() reports the placement for scheduling kernels by node. The policy bounds the number
+// of touching threads. Failures to set a placement throw std::bad_alloc.
+template <typename _type>
+class allocator
+{
+public:
+  using value_type                             = _type;
+  using size_type                              = std::size_t;
+  using difference_type                        = std::ptrdiff_t;
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal                        = std::true_type;
+
+  constexpr          allocator() noexcept = default;
+  constexpr explicit allocator(numa::placement placement, const execution::parallel_policy& policy = execution::par) noexcept
+  : placement_(placement), policy_(policy)
+  {
+
+  }
+  template <typename _other>
+  constexpr          allocator(const allocator<_other>& that) noexcept
+  : placement_(that.placement()), policy_(that.policy())
+  {
+
+  }
+
+  _type*                             allocate  (size_type size)
+  {
+    if (size > std::numeric_limits<size_type>::max() / sizeof(_type))
+      throw std::bad_array_new_length();
+
+    const auto bytes = mapped_size(size);
+#if defined(__linux__)
+    const auto data  = static_cast<std::byte*>(mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (data == MAP_FAILED)
+      throw std::bad_alloc();
+
+    const auto& nodes = memory_nodes();
+    const auto  page  = page_size();
+    const auto  pages = bytes / page;
+    const auto  fail  = [&]
+    {
+      munmap(data, bytes);
+      throw std::bad_alloc();
+    };
+    if (placement_ == numa::placement::interleaved && nodes.size() > 1 && !detail::bind(data, bytes, MPOL_INTERLEAVE, nodes))
+      fail();
+    if (placement_ == numa::placement::first_touch && nodes.size() > 1)
+    {
+      for (std::size_t n = 0; n < nodes.size(); ++n)
+      {
+        const auto [begin, end] = partition_range(pages, nodes.size(), n);
+        if (begin != end && !detail::bind(data + begin * page, (end - begin) * page, MPOL_PREFERRED, {nodes[n]}))
+          fail();
+      }
+
+      // Threads of their own, as pinning changes their affinity for good. Pinning is best effort: the bound policy
+      // already places the pages, and pinned threads fault them in from the local node.
+      const auto               count = std::min(concurrency(policy_), nodes.size());
+      std::vector<std::thread> threads;
+      threads.reserve(count);
+      for (std::size_t t = 0; t < count; ++t)
+        threads.emplace_back([&, t]
+        {
+          for (auto n = t; n < nodes.size(); n += count)
+          {
+            detail::pin(nodes[n]);
+            const auto [begin, end] = partition_range(pages, nodes.size(), n);
+            for (auto i = begin; i < end; ++i)
+              *static_cast<volatile std::byte*>(data + i * page) = std::byte(0);
+          }
+        });
+      for (auto& thread : threads)
+        thread.join();
+    }
+    else if (placement_ != numa::placement::local)
+      for_each_index(policy_, pages, [&] (const std::size_t i)
+      {
+        *static_cast<volatile std::byte*>(data + i * page) = std::byte(0);
+      });
+#else
+    const auto data  = static_cast<std::byte*>(std::aligned_alloc(page_size(), bytes));
+    if (!data)
+      throw std::bad_alloc();
+#endif
+    return reinterpret_cast<_type*>(data);
+  }
+  void                               deallocate(_type* pointer, size_type size) noexcept
+  {
+#if defined(__linux__)
+    munmap(pointer, mapped_size(size));
+#else
+    std::free(pointer);
+#endif
+  }
+
+  constexpr numa::placement          placement () const noexcept
+  {
+    return placement_;
+  }
+  constexpr execution::parallel_policy policy  () const noexcept
+  {
+    return policy_;
+  }
+
+protected:
+  static size_type                   mapped_size(size_type size) noexcept
+  {
+    const auto page = page_size();
+    return std::max<size_type>((size * sizeof(_type) + page - 1) / page * page, page);
+  }
+
+  numa::placement            placement_ = numa::placement::first_touch;
+  execution::parallel_policy policy_    {};
+};
+
+template <typename _lhs, typename _rhs>
+constexpr bool operator==(const allocator<_lhs>&, const allocator<_rhs>&) noexcept
+{
+  return true;
+}
+
+template <
+  typename    _type      ,
+  std::size_t _dimensions,
+  typename    _layout    = std::experimental::layout_right,
+  typename    _accessor  = std::experimental::default_accessor<_type>>
+using vector = multi::vector<_type, _dimensions, _layout, _accessor, numa::allocator<_type>>;
+
+// Node of the page containing each address, or -1 for pages which are not resident or cannot be queried.
+inline std::vector<int> nodes_of(const std::vector<const void*>& addresses)
+{
+  std::vector<int> result(addresses.size(), -1);
+#if defined(__linux__)
+  constexpr std::size_t batch_size = 4096;
+  for (std::size_t begin = 0; begin < addresses.size(); begin += batch_size)
+  {
+    const auto count = std::min(batch_size, addresses.size() - begin);
+    if (syscall(SYS_move_pages, 0, count, const_cast<const void**>(addresses.data() + begin), nullptr, result.data() + begin, 0) != 0)
+      std::fill_n(result.data() + begin, count, -1);
+  }
+  for (auto& node : result)
+    node = node >= 0 ? node : -1;
+#else
+  std::fill(result.begin(), result.end(), 0);
+#endif
+  return result;
+}
+
+struct node_range
+{
+  std::size_t begin;
+  std::size_t end  ;
+  int         node ;
+};
+
+// Maximal ranges of the outermost axis whose leading elements reside on the same node.
+template <typename _type, std::size_t _dimensions, typename _accessor, typename _allocator>
+std::vector<node_range> outer_ranges(const multi::vector<_type, _dimensions, std::experimental::layout_right, _accessor, _allocator>& vector)
+{
+  const auto extent = vector.empty() ? std::size_t(0) : vector.dimensions()[0];
+  const auto stride = extent == 0 ? std::size_t(0) : vector.size() / extent;
+
+  std::vector<const void*> addresses(extent);
+  for (std::size_t i = 0; i < extent; ++i)
+    addresses[i] = vector.data() + i * stride;
+  const auto nodes = nodes_of(addresses);
+
+  std::vector<node_range> result;
+  for (std::size_t i = 0; i < extent; ++i)
+  {
+    if (result.empty() || result.back().node != nodes[i])
+      result.push_back({i, i + 1, nodes[i]});
+    else
+      result.back().end = i + 1;
+  }
+  return result;
+}
+}
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <multi/vector.hpp>
+
+namespace multi
+{
+struct access_report
+{
+  std::size_t                                     access_count      = 0; // All accesses, including unsampled ones.
+  std::size_t                                     sample_count      = 0;
+  std::size_t                                     dropped_count     = 0; // Samples lost to full buffers.
+  std::vector<std::map<std::ptrdiff_t, std::size_t>> stride_histograms;    // Per axis, of consecutive samples.
+  std::map<std::size_t, std::size_t>              reuse_distances   ;    // Distinct cache lines in between, by power of two.
+  std::size_t                                     cold_count        = 0; // Samples touching a cache line first.
+  std::size_t                                     cache_line_count  = 0;
+  std::size_t                                     page_count        = 0;
+};
+
+struct profiling_settings
+{
+  std::size_t   sampling_period = 1;       // Bursts of burst_length accesses are recorded out of every period.
+  std::size_t   burst_length    = 1;
+  std::size_t   buffer_capacity = 1 << 20; // Per thread, in samples.
+  std::size_t   cache_line_size = 64;
+  std::size_t   page_size       = 4096;
+  std::ostream* output          = &std::clog;
+};
+
+// Collects sampled accesses through profiling_accessors. Each thread appends to a buffer of its own without locking;
+// the report is built on request, and printed on destruction, when no accesses may be in flight.
+class access_profiler
+{
+public:
+  // The strides recover per-axis positions from offsets (of exhaustive layouts). They are taken from the profiled mapping.
+  explicit access_profiler(std::vector<std::ptrdiff_t> strides = {1}, const profiling_settings& settings = {})
+  : strides_(std::move(strides)), settings_(settings), id_(next_id())
+  {
+    settings_.sampling_period = std::max<std::size_t>(settings_.sampling_period, 1);
+    settings_.burst_length    = std::clamp<std::size_t>(settings_.burst_length, 1, settings_.sampling_period);
+  }
+  template <typename _mapping>
+  explicit access_profiler(const _mapping& mapping, const profiling_settings& settings = {})
+  : access_profiler(strides_of(mapping), settings)
+  {
+
+  }
+  access_profiler(const access_profiler&  that) = delete;
+  access_profiler(      access_profiler&& temp) = delete;
+  ~access_profiler()
+  {
+    if (settings_.output)
+      print(*settings_.output, report());
+  }
+
+  access_profiler& operator=(const access_profiler&  that) = delete;
+  access_profiler& operator=(      access_profiler&& temp) = delete;
+
+  void                       record  (std::uintptr_t address, std::ptrdiff_t offset)
+  {
+    auto&      buffer = local_buffer();
+    const auto phase  = buffer.access_count++ % settings_.sampling_period;
+    if (phase >= settings_.burst_length)
+      return;
+    if (buffer.samples.size() >= settings_.buffer_capacity)
+    {
+      ++buffer.dropped_count;
+      return;
+    }
+    buffer.samples.push_back({address, offset, phase == 0 && settings_.burst_length < settings_.sampling_period});
+  }
+
+  access_report              report  () const
+  {
+    std::lock_guard lock(mutex_);
+
+    access_report result;
+    result.stride_histograms.resize(strides_.size());
+
+    std::unordered_set<std::uintptr_t> lines;
+    std::unordered_set<std::uintptr_t> pages;
+    for (const auto& [thread, buffer] : buffers_)
+    {
+      result.access_count  += buffer->access_count;
+      result.sample_count  += buffer->samples.size();
+      result.dropped_count += buffer->dropped_count;
+
+      for (const auto& sample : buffer->samples)
+      {
+        lines.insert(sample.address / settings_.cache_line_size);
+        pages.insert(sample.address / settings_.page_size);
+      }
+
+      // Strides and reuse distances are measured within contiguous runs of samples.
+      for (std::size_t begin = 0, end; begin < buffer->samples.size(); begin = end)
+      {
+        for (end = begin + 1; end < buffer->samples.size() && !buffer->samples[end].starts_burst; ++end);
+        analyze(buffer->samples.data() + begin, buffer->samples.data() + end, result);
+      }
+    }
+    result.cache_line_count = lines.size();
+    result.page_count       = pages.size();
+    return result;
+  }
+  // Sample counts per cache line, from the lowest to the highest sampled line. The first line address is optional.
+  vector<std::size_t, 1>     heat_map(std::uintptr_t* first_line = nullptr) const
+  {
+    std::lock_guard lock(mutex_);
+
+    auto minimum = std::numeric_limits<std::uintptr_t>::max();
+    auto maximum = std::uintptr_t(0);
+    for (const auto& [thread, buffer] : buffers_)
+      for (const auto& sample : buffer->samples)
+      {
+        minimum = std::min(minimum, sample.address / settings_.cache_line_size);
+        maximum = std::max(maximum, sample.address / settings_.cache_line_size);
+      }
+    if (first_line)
+      *first_line = minimum <= maximum ? minimum * settings_.cache_line_size : 0;
+    if (minimum > maximum)
+      return vector<std::size_t, 1>();
+
+    vector<std::size_t, 1> result(maximum - minimum + 1, std::size_t(0));
+    for (const auto& [thread, buffer] : buffers_)
+      for (const auto& sample : buffer->samples)
+        ++result[sample.address / settings_.cache_line_size - minimum];
+    return result;
+  }
+
+  static void                print   (std::ostream& stream, const access_report& report)
+  {
+    stream << "multi::access_profiler: " << report.access_count << " accesses, " << report.sample_count << " samples, " << report.dropped_count << " dropped\n";
+    stream << "  touched: " << report.cache_line_count << " cache lines, " << report.page_count << " pages\n";
+    for (std::size_t axis = 0; axis < report.stride_histograms.size(); ++axis)
+    {
+      // The eight most frequent strides.
+      std::vector<std::pair<std::ptrdiff_t, std::size_t>> strides(report.stride_histograms[axis].begin(), report.stride_histograms[axis].end());
+      std::sort(strides.begin(), strides.end(), [ ] (const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+      stream << "  axis " << axis << " strides:";
+      for (std::size_t i = 0; i < std::min<std::size_t>(strides.size(), 8); ++i)
+        stream << " " << strides[i].first << " (" << strides[i].second << ")";
+      stream << "\n";
+    }
+    stream << "  reuse distances:";
+    for (const auto& [distance, count] : report.reuse_distances)
+      stream << " <=" << (distance > 0 ? 2 * distance - 1 : 0) << " (" << count << ")";
+    stream << " cold (" << report.cold_count << ")\n";
+  }
+
+  template <typename _mapping>
+  static std::vector<std::ptrdiff_t> strides_of(const _mapping& mapping)
+  {
+    std::vector<std::ptrdiff_t> result(_mapping::extents_type::rank());
+    for (std::size_t i = 0; i < result.size(); ++i)
+      result[i] = static_cast<std::ptrdiff_t>(mapping.stride(i));
+    return result;
+  }
+
+  const profiling_settings&  get_settings() const noexcept
+  {
+    return settings_;
+  }
+
+protected:
+  struct sample
+  {
+    std::uintptr_t address     ;
+    std::ptrdiff_t offset      ;
+    bool           starts_burst;
+  };
+  struct buffer
+  {
+    std::vector<sample> samples      ;
+    std::size_t         access_count  = 0;
+    std::size_t         dropped_count = 0;
+  };
+
+  static std::uint64_t       next_id () noexcept
+  {
+    static std::atomic<std::uint64_t> counter {0};
+    return ++counter;
+  }
+
+  // Threads cache the buffer of the last profiler they recorded into; the registry is only locked on a cache miss.
+  buffer&                    local_buffer()
+  {
+    thread_local std::pair<std::uint64_t, buffer*> cache {0, nullptr};
+    if (cache.first != id_)
+    {
+      std::lock_guard lock(mutex_);
+      auto& entry = buffers_[std::this_thread::get_id()];
+      if (!entry)
+        entry = std::make_unique<buffer>();
+      cache = {id_, entry.get()};
+    }
+    return *cache.second;
+  }
+
+  void                       analyze (const sample* first, const sample* last, access_report& report) const
+  {
+    // Per-axis steps between the positions recovered from the offsets, decomposing from the largest stride down.
+    std::vector<std::size_t> order(strides_.size());
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::sort(order.begin(), order.end(), [&] (std::size_t lhs, std::size_t rhs) { return std::abs(strides_[lhs]) > std::abs(strides_[rhs]); });
+    const auto position = [&] (std::ptrdiff_t offset, std::size_t axis)
+    {
+      for (const auto other : order)
+      {
+        const auto index = strides_[other] != 0 ? offset / strides_[other] : 0;
+        if (other == axis)
+          return index;
+        offset -= index * strides_[other];
+      }
+      return std::ptrdiff_t(0);
+    };
+    for (auto current = first + 1; current < last; ++current)
+      for (std::size_t axis = 0; axis < strides_.size(); ++axis)
+        ++report.stride_histograms[axis][position(current->offset, axis) - position((current - 1)->offset, axis)];
+
+    // Reuse distances by counting the most recent accesses of distinct lines (in a Fenwick tree over sample positions).
+    const auto                                      size = static_cast<std::size_t>(last - first);
+    std::vector<std::size_t>                        tree(size + 1, 0);
+    std::unordered_map<std::uintptr_t, std::size_t> previous;
+    const auto update = [&] (std::size_t position, std::ptrdiff_t value)
+    {
+      for (++position; position <= size; position += position & (~position + 1))
+        tree[position] += value;
+    };
+    const auto prefix = [&] (std::size_t position)
+    {
+      std::size_t result = 0;
+      for (; position > 0; position -= position & (~position + 1))
+        result += tree[position];
+      return result;
+    };
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      const auto line = first[i].address / settings_.cache_line_size;
+      if (const auto iterator = previous.find(line); iterator != previous.end())
+      {
+        const auto distance = prefix(i) - prefix(iterator->second + 1);
+        ++report.reuse_distances[distance > 0 ? std::bit_floor(distance) : 0];
+        update(iterator->second, -1);
+        iterator->second = i;
+      }
+      else
+      {
+        ++report.cold_count;
+        previous.emplace(line, i);
+      }
+      update(i, 1);
+    }
+  }
+
+  std::vector<std::ptrdiff_t>                                   strides_ ;
+  profiling_settings                                            settings_;
+  std::uint64_t                                                 id_      ;
+  mutable std::mutex                                            mutex_   ;
+  std::unordered_map<std::thread::id, std::unique_ptr<buffer>> buffers_ ;
+};
+
+// Accessor recording each access into a shared access_profiler before forwarding it to the wrapped accessor. Default
+// constructed instances do not record. Linear element access of the containers bypasses accessors and is not recorded.
+template <typename _accessor>
+class profiling_accessor
+{
+public:
+  using accessor_type = _accessor;
+  using offset_policy = profiling_accessor<typename accessor_type::offset_policy>;
+  using element_type  = typename accessor_type::element_type;
+  using reference     = typename accessor_type::reference;
+  using pointer       = typename accessor_type::pointer;
+
+  constexpr          profiling_accessor() noexcept = default;
+  explicit           profiling_accessor(std::shared_ptr<access_profiler> profiler, const accessor_type& accessor = accessor_type())
+  : profiler_(std::move(profiler)), accessor_(accessor)
+  {
+
+  }
+  template <typename _other>
+  constexpr          profiling_accessor(const profiling_accessor<_other>& that)
+  : profiler_(that.profiler()), accessor_(that.nested_accessor())
+  {
+
+  }
+
+  constexpr typename offset_policy::pointer offset(pointer p, std::size_t i) const noexcept
+  {
+    return accessor_.offset(p, i);
+  }
+  constexpr reference                         access(pointer p, std::size_t i) const
+  {
+    if (profiler_)
+      profiler_->record(reinterpret_cast<std::uintptr_t>(accessor_.offset(p, i)), static_cast<std::ptrdiff_t>(i));
+    return accessor_.access(p, i);
+  }
+
+  const std::shared_ptr<access_profiler>&     profiler       () const noexcept
+  {
+    return profiler_;
+  }
+  constexpr const accessor_type&              nested_accessor() const noexcept
+  {
+    return accessor_;
+  }
+
+protected:
+  std::shared_ptr<access_profiler> profiler_;
+  accessor_type                    accessor_ {};
+};
+}
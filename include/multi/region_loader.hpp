@@ -0,0 +1,651 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include <multi/thread_pool.hpp>
+#include <multi/vector.hpp>
+
+namespace multi
+{
+// Reads files asynchronously, keeping at most depth requests in flight and queueing the others. Uses io_uring where
+// the kernel permits it and threads calling pread otherwise. Callbacks run on the completion threads, or on the
+// submitting thread for requests the ring fails to submit, and must not block.
+class io_queue
+{
+public:
+  // Receives the byte count, smaller than requested only at the end of the file, or a negated errno.
+  using callback_type = std::function<void(std::ptrdiff_t)>;
+
+  explicit io_queue(std::size_t depth = 32, std::size_t thread_count = 4, bool io_uring = true)
+  : depth_(std::max<std::size_t>(depth, 1))
+  {
+    if (io_uring && ring_.open(depth_))
+      threads_.emplace_back([this] { reap(); });
+    else
+      // Each thread has one request in flight.
+      for (std::size_t i = 0; i < std::clamp<std::size_t>(thread_count, 1, depth_); ++i)
+        threads_.emplace_back([this] { work(); });
+  }
+  io_queue(const io_queue&  that) = delete;
+  io_queue(      io_queue&& temp) = delete;
+  // Completes the pending requests first.
+  ~io_queue()
+  {
+    {
+      std::unique_lock lock(mutex_);
+      idle_condition_.wait(lock, [&] { return pending_.empty() && in_flight_ == 0; });
+      stop_ = true;
+      if (ring_.is_open())
+      {
+        ring_.push(nullptr);
+        flush(lock, true);
+      }
+    }
+    work_condition_.notify_all();
+    for (auto& thread : threads_)
+      thread.join();
+    ring_.close();
+  }
+
+  io_queue&   operator=    (const io_queue&  that) = delete;
+  io_queue&   operator=    (      io_queue&& temp) = delete;
+
+  // Reads size bytes at the offset of the file into the data, resubmitting the remainder of short reads.
+  void        read         (int file, void* data, std::size_t size, std::size_t offset, callback_type callback)
+  {
+    auto request = std::make_unique<io_request>(io_request {file, static_cast<std::byte*>(data), size, offset, 0, std::move(callback), {}});
+    {
+      std::unique_lock lock(mutex_);
+      if (ring_.is_open() && in_flight_ < depth_)
+      {
+        ++in_flight_;
+        ring_.push(request.release());
+        flush(lock, true);
+        lock.unlock();
+        fail(true);
+        return;
+      }
+      pending_.push_back(std::move(request));
+    }
+    work_condition_.notify_one();
+  }
+
+  std::size_t depth        () const noexcept
+  {
+    return depth_;
+  }
+  bool        uses_io_uring() const noexcept
+  {
+    return ring_.is_open();
+  }
+
+protected:
+  struct io_request
+  {
+    int           file    ;
+    std::byte*    data    ;
+    std::size_t   size    ;
+    std::size_t   offset  ;
+    std::size_t   done    ;
+    callback_type callback;
+    iovec         vector  ; // Stable storage for the submitted readv.
+  };
+
+  // Minimal io_uring submission and completion rings, driven through raw system calls. Submissions are serialized by
+  // the queue's mutex. Each request occupies at most one submission entry at a time, so that the ring, sized for depth
+  // requests and the wake-up, never overflows while the kernel defers entries.
+  class ring
+  {
+  public:
+    bool        open    (std::size_t depth)
+    {
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+      io_uring_params parameters {};
+      // Leaves room in the completion ring for the wake-up request.
+      file_ = static_cast<int>(syscall(__NR_io_uring_setup, static_cast<unsigned>(depth + 1), &parameters));
+      if (file_ < 0)
+        return false;
+
+      submission_size_ = parameters.sq_off.array + parameters.sq_entries * sizeof(unsigned);
+      completion_size_ = parameters.cq_off.cqes  + parameters.cq_entries * sizeof(io_uring_cqe);
+      entries_size_    = parameters.sq_entries * sizeof(io_uring_sqe);
+      if (parameters.features & IORING_FEAT_SINGLE_MMAP)
+        submission_size_ = completion_size_ = std::max(submission_size_, completion_size_);
+
+      submission_ = map(submission_size_, IORING_OFF_SQ_RING);
+      completion_ = parameters.features & IORING_FEAT_SINGLE_MMAP ? submission_ : map(completion_size_, IORING_OFF_CQ_RING);
+      entries_    = static_cast<io_uring_sqe*>(map(entries_size_, IORING_OFF_SQES));
+      if (!submission_ || !completion_ || !entries_)
+      {
+        close();
+        return false;
+      }
+
+      const auto submission = static_cast<std::byte*>(submission_);
+      const auto completion = static_cast<std::byte*>(completion_);
+      submission_tail_  = reinterpret_cast<unsigned*>    (submission + parameters.sq_off.tail        );
+      submission_mask_  = reinterpret_cast<unsigned*>    (submission + parameters.sq_off.ring_mask   );
+      submission_array_ = reinterpret_cast<unsigned*>    (submission + parameters.sq_off.array       );
+      completion_head_  = reinterpret_cast<unsigned*>    (completion + parameters.cq_off.head        );
+      completion_tail_  = reinterpret_cast<unsigned*>    (completion + parameters.cq_off.tail        );
+      completion_mask_  = reinterpret_cast<unsigned*>    (completion + parameters.cq_off.ring_mask   );
+      completions_      = reinterpret_cast<io_uring_cqe*>(completion + parameters.cq_off.cqes        );
+      return true;
+#else
+      return false;
+#endif
+    }
+    void        close   ()
+    {
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+      if (entries_)
+        munmap(entries_, entries_size_);
+      if (completion_ && completion_ != submission_)
+        munmap(completion_, completion_size_);
+      if (submission_)
+        munmap(submission_, submission_size_);
+      if (file_ >= 0)
+        ::close(file_);
+      submission_ = completion_ = nullptr;
+      entries_    = nullptr;
+      file_       = -1;
+#endif
+    }
+    bool        is_open () const noexcept
+    {
+      return file_ >= 0;
+    }
+
+    // Writes a readv of the remainder of the request, or a no-op waking the reaper for a null request, to the
+    // submission ring, to be submitted by flush.
+    void        push    (io_request* request)
+    {
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+      const auto tail  = *submission_tail_;
+      const auto index = tail & *submission_mask_;
+      auto&      entry = entries_[index];
+      entry = io_uring_sqe {};
+      if (request)
+      {
+        request->vector = {request->data + request->done, request->size - request->done};
+        entry.opcode    = IORING_OP_READV;
+        entry.fd        = request->file;
+        entry.off       = request->offset + request->done;
+        entry.addr      = reinterpret_cast<std::uint64_t>(&request->vector);
+        entry.len       = 1;
+      }
+      else
+        entry.opcode    = IORING_OP_NOP;
+      entry.user_data   = reinterpret_cast<std::uint64_t>(request);
+      submission_array_[index] = index;
+      std::atomic_ref<unsigned>(*submission_tail_).store(tail + 1, std::memory_order_release);
+      ++unsubmitted_;
+#endif
+    }
+    // Submits the pushed entries. Entries the kernel cannot take yet (EAGAIN, EBUSY) remain deferred for the next
+    // flush. Returns 0, or a negated errno if the ring failed.
+    int         flush   ()
+    {
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+      while (unsubmitted_ > 0)
+      {
+        const auto result = syscall(__NR_io_uring_enter, file_, unsubmitted_, 0u, 0u, nullptr, 0);
+        if (result > 0)
+          unsubmitted_ -= static_cast<unsigned>(result);
+        else if (result == 0 || errno == EAGAIN || errno == EBUSY)
+          return 0;
+        else if (errno != EINTR)
+          return -errno;
+      }
+#endif
+      return 0;
+    }
+    // Takes back the entries which were not submitted, calling function(request) for each.
+    template <typename _function>
+    void        withdraw(_function&& function)
+    {
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+      auto tail = *submission_tail_;
+      for (; unsubmitted_ > 0; --unsubmitted_)
+        function(reinterpret_cast<io_request*>(entries_[--tail & *submission_mask_].user_data));
+      std::atomic_ref<unsigned>(*submission_tail_).store(tail, std::memory_order_release);
+#endif
+    }
+    bool        deferred() const noexcept
+    {
+      return unsubmitted_ != 0;
+    }
+    // Calls function(request, result) for each available completion, blocking until there is one if wait.
+    template <typename _function>
+    void        complete(bool wait, _function&& function)
+    {
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+      if (wait)
+        while (syscall(__NR_io_uring_enter, file_, 0u, 1u, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno == EINTR);
+
+      auto       head = *completion_head_;
+      const auto tail = std::atomic_ref<unsigned>(*completion_tail_).load(std::memory_order_acquire);
+      for (; head != tail; ++head)
+      {
+        const auto& entry = completions_[head & *completion_mask_];
+        const auto  request = reinterpret_cast<io_request*>(entry.user_data);
+        const auto  result  = entry.res;
+        std::atomic_ref<unsigned>(*completion_head_).store(head + 1, std::memory_order_release);
+        function(request, result);
+      }
+#endif
+    }
+
+  protected:
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+    void*       map     (std::size_t size, std::uint64_t offset) const
+    {
+      const auto result = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, file_, static_cast<off_t>(offset));
+      return result != MAP_FAILED ? result : nullptr;
+    }
+
+    void*         submission_       = nullptr;
+    void*         completion_       = nullptr;
+    io_uring_sqe* entries_          = nullptr;
+    std::size_t   submission_size_  = 0;
+    std::size_t   completion_size_  = 0;
+    std::size_t   entries_size_     = 0;
+    unsigned*     submission_tail_  = nullptr;
+    unsigned*     submission_mask_  = nullptr;
+    unsigned*     submission_array_ = nullptr;
+    unsigned*     completion_head_  = nullptr;
+    unsigned*     completion_tail_  = nullptr;
+    unsigned*     completion_mask_  = nullptr;
+    io_uring_cqe* completions_      = nullptr;
+#endif
+    unsigned      unsubmitted_      = 0;
+    int           file_             = -1;
+  };
+
+  static std::ptrdiff_t read_all(const io_request& request)
+  {
+    std::size_t done = 0;
+    while (done < request.size)
+    {
+      const auto result = ::pread(request.file, request.data + done, request.size - done, static_cast<off_t>(request.offset + done));
+      if (result < 0 && errno == EINTR)
+        continue;
+      if (result < 0)
+        return -errno;
+      if (result == 0)
+        break;
+      done += static_cast<std::size_t>(result);
+    }
+    return static_cast<std::ptrdiff_t>(done);
+  }
+
+  void        work         ()
+  {
+    while (true)
+    {
+      std::unique_ptr<io_request> request;
+      {
+        std::unique_lock lock(mutex_);
+        work_condition_.wait(lock, [&] { return stop_ || !pending_.empty(); });
+        if (pending_.empty())
+          return;
+        request = std::move(pending_.front());
+        pending_.pop_front();
+        ++in_flight_;
+      }
+
+      request->callback(read_all(*request));
+      request.reset();
+
+      {
+        std::lock_guard lock(mutex_);
+        --in_flight_;
+      }
+      idle_condition_.notify_all();
+    }
+  }
+  void        reap         ()
+  {
+    auto stop = false;
+    while (!stop)
+    {
+      // Entries the kernel deferred are retried before waiting, and polled for with a backoff while they remain.
+      auto deferred = false;
+      {
+        std::unique_lock lock(mutex_);
+        flush(lock, false);
+        deferred = ring_.deferred();
+      }
+      fail(false);
+      if (deferred)
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+      ring_.complete(!deferred, [&] (io_request* pointer, int result)
+      {
+        if (!pointer)
+        {
+          stop = true;
+          return;
+        }
+
+        std::unique_ptr<io_request> request(pointer);
+        if (result > 0 && (request->done += static_cast<std::size_t>(result)) < request->size)
+        {
+          std::unique_lock lock(mutex_);
+          ring_.push(request.release());
+          flush(lock, false);
+          return;
+        }
+        request->callback(result < 0 ? result : static_cast<std::ptrdiff_t>(request->done));
+        request.reset();
+        release(false);
+      });
+      fail(false);
+    }
+  }
+
+  // Submits the entries pushed to the ring, with the mutex held. If wait, entries the kernel defers are retried with a
+  // backoff until it takes them; otherwise the reaper retries them. If the ring fails, the unsubmitted requests are
+  // withdrawn to fail with the error.
+  void        flush        (std::unique_lock<std::mutex>& lock, bool wait)
+  {
+    for (auto backoff = std::chrono::microseconds(10);; backoff = std::min(backoff * 2, std::chrono::microseconds(10000)))
+    {
+      if (const auto error = ring_.flush(); error < 0)
+        ring_.withdraw([&] (io_request* request)
+        {
+          if (request)
+            failed_.emplace_back(request, error);
+        });
+      if (!wait || !ring_.deferred())
+        return;
+
+      lock.unlock();
+      std::this_thread::sleep_for(backoff);
+      lock.lock();
+    }
+  }
+  // Calls back the withdrawn requests with their errors, with the mutex released.
+  void        fail         (bool wait)
+  {
+    while (true)
+    {
+      std::pair<io_request*, int> failure;
+      {
+        std::lock_guard lock(mutex_);
+        if (failed_.empty())
+          return;
+        failure = failed_.front();
+        failed_.pop_front();
+      }
+
+      std::unique_ptr<io_request> request(failure.first);
+      request->callback(failure.second);
+      request.reset();
+      release(wait);
+    }
+  }
+  // Hands the in-flight slot of a finished request to the next pending one, or frees it.
+  void        release      (bool wait)
+  {
+    {
+      std::unique_lock lock(mutex_);
+      if (!pending_.empty())
+      {
+        ring_.push(pending_.front().release());
+        pending_.pop_front();
+        flush(lock, wait);
+      }
+      else
+        --in_flight_;
+    }
+    idle_condition_.notify_all();
+  }
+
+  std::size_t                             depth_          ;
+  ring                                    ring_           ;
+  std::vector<std::thread>                threads_        ;
+  std::deque<std::unique_ptr<io_request>> pending_        ;
+  std::deque<std::pair<io_request*, int>> failed_         ;
+  std::size_t                             in_flight_      = 0;
+  bool                                    stop_           = false;
+  std::mutex                              mutex_          ;
+  std::condition_variable                 work_condition_ ;
+  std::condition_variable                 idle_condition_ ;
+};
+
+inline io_queue& default_io_queue()
+{
+  static io_queue queue;
+  return queue;
+}
+
+// Loads boxes of a volume stored as a raw array of elements in layout_right order, from an offset of a file. Rows are
+// fused across the trailing axes a box fully covers, split into requests of at most request_size bytes, and issued
+// together through an io_queue. Loads must complete before the loader is destroyed.
+template <typename _type, std::size_t _dimensions>
+class region_loader
+{
+public:
+  using vector_type     = vector<_type, _dimensions>;
+  using value_type      = typename vector_type::value_type;
+  using size_type       = typename vector_type::size_type;
+  using multi_size_type = typename vector_type::multi_size_type;
+  using box_type        = box<_dimensions>;
+
+  static_assert(std::is_trivially_copyable_v<value_type>, "The element type must be trivially copyable.");
+
+  // Awaitable resuming the awaiting coroutine on a completion thread once the region is read. Started once, either by
+  // co_await or by get. I/O errors, including files too short for the volume, are thrown as std::system_error.
+  class operation
+  {
+  public:
+    bool        await_ready  () const noexcept
+    {
+      return state_->requests.empty();
+    }
+    bool        await_suspend(std::coroutine_handle<> continuation)
+    {
+      state_->continuation = continuation;
+      return !start();
+    }
+    vector_type await_resume ()
+    {
+      if (const auto error = state_->error.load(std::memory_order_acquire))
+        throw std::system_error(error, std::generic_category(), "multi::region_loader::load");
+      return std::move(state_->result);
+    }
+
+    // Blocks the calling thread until the region is read.
+    vector_type get          ()
+    {
+      if (!start())
+        for (auto remaining = state_->remaining.load(std::memory_order_acquire); remaining != 0; remaining = state_->remaining.load(std::memory_order_acquire))
+          state_->remaining.wait(remaining, std::memory_order_acquire);
+      return await_resume();
+    }
+
+    size_type   request_count() const noexcept
+    {
+      return state_->requests.size();
+    }
+
+  protected:
+    friend class region_loader;
+
+    struct request
+    {
+      std::size_t offset; // In bytes, in the file.
+      std::size_t index ; // In elements, in the result.
+      std::size_t size  ; // In bytes.
+    };
+    struct state
+    {
+      void finish()
+      {
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+          return;
+        if (continuation)
+          continuation.resume();
+        else
+          remaining.notify_all();
+      }
+
+      const region_loader*     loader      ;
+      vector_type              result      ;
+      std::vector<request>     requests    ;
+      std::atomic<std::size_t> remaining   {0};
+      std::atomic<int>         error       {0};
+      std::coroutine_handle<>  continuation;
+    };
+
+    explicit operation(std::shared_ptr<state> state)
+    : state_(std::move(state))
+    {
+
+    }
+
+    // Issues the requests. Returns true if they all completed before returning.
+    bool        start        ()
+    {
+      state_->remaining.store(state_->requests.size() + 1, std::memory_order_relaxed);
+      for (const auto& request : state_->requests)
+        state_->loader->queue_->read(state_->loader->file_, state_->result.data() + request.index, request.size, request.offset, [state = state_, size = request.size] (std::ptrdiff_t result)
+        {
+          if (result < 0 || static_cast<std::size_t>(result) != size)
+          {
+            auto expected = 0;
+            state->error.compare_exchange_strong(expected, result < 0 ? static_cast<int>(-result) : EIO, std::memory_order_release);
+          }
+          state->finish();
+        });
+      return state_->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    std::shared_ptr<state> state_;
+  };
+
+  // The file is opened read only, and closed on destruction.
+  region_loader(const std::string& path, const multi_size_type& dimensions, std::size_t offset = 0, io_queue& queue = default_io_queue(), std::size_t request_size = 1 << 20)
+  : region_loader(::open(path.c_str(), O_RDONLY | O_CLOEXEC), dimensions, offset, queue, request_size)
+  {
+    if (file_ < 0)
+      throw std::system_error(errno, std::generic_category(), "multi::region_loader");
+    owns_file_ = true;
+  }
+  // The file descriptor is not owned.
+  region_loader(int file, const multi_size_type& dimensions, std::size_t offset = 0, io_queue& queue = default_io_queue(), std::size_t request_size = 1 << 20)
+  : file_(file), dimensions_(dimensions), offset_(offset), queue_(&queue), request_size_(std::max(request_size / sizeof(value_type), std::size_t(1)) * sizeof(value_type))
+  {
+
+  }
+  region_loader(const region_loader&  that) = delete;
+  region_loader(      region_loader&& temp) = delete;
+  ~region_loader()
+  {
+    if (owns_file_)
+      ::close(file_);
+  }
+
+  region_loader&         operator=   (const region_loader&  that) = delete;
+  region_loader&         operator=   (      region_loader&& temp) = delete;
+
+  operation              load        (const box_type& region) const
+  {
+    multi_size_type extent;
+    for (std::size_t i = 0; i < _dimensions; ++i)
+    {
+      if (region.begin[i] > region.end[i] || region.end[i] > dimensions_[i])
+        throw std::out_of_range("multi::region_loader::load");
+      extent[i] = region.end[i] - region.begin[i];
+    }
+
+    auto state    = std::make_shared<typename operation::state>();
+    state->loader = this;
+    if constexpr (_dimensions == 1)
+      state->result = vector_type(extent[0], value_type());
+    else
+      state->result = vector_type(extent, value_type());
+    if (region.empty())
+      return operation(std::move(state));
+
+    // Runs are contiguous across the trailing axes covered entirely, and along the first axis which is not.
+    std::size_t fused = _dimensions - 1;
+    while (fused > 0 && extent[fused] == dimensions_[fused])
+      --fused;
+    std::size_t run_length = 1;
+    for (auto i = fused; i < _dimensions; ++i)
+      run_length *= extent[i];
+    const auto run_count = state->result.size() / run_length;
+
+    for (std::size_t run = 0; run < run_count; ++run)
+    {
+      // Position of the run's first element, decomposing the run index over the leading axes.
+      auto        position  = region.begin;
+      auto        remainder = run;
+      for (auto i = fused; i-- > 0;)
+      {
+        position[i] += remainder % extent[i];
+        remainder   /= extent[i];
+      }
+      std::size_t element = 0;
+      for (std::size_t i = 0; i < _dimensions; ++i)
+        element = element * dimensions_[i] + position[i];
+
+      const auto first = offset_ + element * sizeof(value_type);
+      const auto bytes = run_length * sizeof(value_type);
+      for (std::size_t done = 0; done < bytes; done += request_size_)
+        state->requests.push_back({first + done, run * run_length + done / sizeof(value_type), std::min(request_size_, bytes - done)});
+    }
+    return operation(std::move(state));
+  }
+
+  const multi_size_type& dimensions  () const noexcept
+  {
+    return dimensions_;
+  }
+  io_queue&              queue       () const noexcept
+  {
+    return *queue_;
+  }
+  std::size_t            request_size() const noexcept
+  {
+    return request_size_;
+  }
+
+protected:
+  int             file_        ;
+  multi_size_type dimensions_  ;
+  std::size_t     offset_      ;
+  io_queue*       queue_       ;
+  std::size_t     request_size_;
+  bool            owns_file_   = false;
+};
+}
@@ -0,0 +1,369 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace multi::simd
+{
+enum class instruction_set
+{
+  scalar,
+  sse4  , // 16-byte registers.
+  avx2  , // 32-byte registers.
+  avx512  // 64-byte registers (F, BW, DQ and VL).
+};
+
+// The widest instruction set supported by the processor, among those the kernels are compiled for.
+inline instruction_set detected_instruction_set() noexcept
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  static const auto result = []
+  {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl"))
+      return instruction_set::avx512;
+    if (__builtin_cpu_supports("avx2"))
+      return instruction_set::avx2;
+    if (__builtin_cpu_supports("sse4.2"))
+      return instruction_set::sse4;
+    return instruction_set::scalar;
+  }();
+  return result;
+#else
+  return instruction_set::scalar;
+#endif
+}
+
+namespace detail
+{
+inline std::atomic<instruction_set>& instruction_set_limit() noexcept
+{
+  static std::atomic<instruction_set> limit {instruction_set::avx512};
+  return limit;
+}
+}
+
+// Caps the instruction set the kernels dispatch to, e.g. to compare the code paths. Returns the previous cap.
+inline instruction_set limit_instruction_set (instruction_set limit) noexcept
+{
+  return detail::instruction_set_limit().exchange(limit);
+}
+inline instruction_set active_instruction_set() noexcept
+{
+  return std::min(detected_instruction_set(), detail::instruction_set_limit().load(std::memory_order_relaxed));
+}
+
+namespace detail
+{
+// Element types mapped to SIMD registers. Others are processed by the standard algorithms.
+template <typename _type>
+inline constexpr bool vectorizable =
+#if defined(__GNUC__)
+  (std::is_integral_v<_type> && !std::is_same_v<_type, bool>) || std::is_same_v<_type, float> || std::is_same_v<_type, double>;
+#else
+  false;
+#endif
+
+#if defined(__GNUC__)
+template <typename _type, std::size_t _bytes>
+using vector_type [[gnu::vector_size(_bytes)]] = _type;
+#else
+template <typename _type, std::size_t _bytes>
+using vector_type = _type;
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+// The kernels are generic lambdas over the register width, inlined into these entry points to be compiled for each
+// instruction set.
+template <typename _kernel>
+[[gnu::target("sse4.2")]]
+decltype(auto) run_sse4  (_kernel& kernel)
+{
+  return kernel.template operator()<16>();
+}
+template <typename _kernel>
+[[gnu::target("avx2")]]
+decltype(auto) run_avx2  (_kernel& kernel)
+{
+  return kernel.template operator()<32>();
+}
+template <typename _kernel>
+[[gnu::target("avx512f,avx512bw,avx512dq,avx512vl")]]
+decltype(auto) run_avx512(_kernel& kernel)
+{
+  return kernel.template operator()<64>();
+}
+#endif
+
+// Calls kernel.template operator()<bytes>() with the register width of the active instruction set, or zero.
+template <typename _kernel>
+decltype(auto) dispatch  (_kernel&& kernel)
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  switch (active_instruction_set())
+  {
+  case instruction_set::avx512: return run_avx512(kernel);
+  case instruction_set::avx2  : return run_avx2  (kernel);
+  case instruction_set::sse4  : return run_sse4  (kernel);
+  default                     : break;
+  }
+#endif
+  return kernel.template operator()<0>();
+}
+
+// The range of input values which convert to the output type without overflow, closed.
+template <typename _output, typename _input>
+std::pair<_input, _input> saturation_bounds() noexcept
+{
+  using input_limits  = std::numeric_limits<_input >;
+  using output_limits = std::numeric_limits<_output>;
+  if constexpr (std::is_floating_point_v<_output>)
+    return {input_limits::lowest(), input_limits::max()};
+  else if constexpr (std::is_floating_point_v<_input>)
+  {
+    // The integer limits round to powers of two, of which the upper one is out of range.
+    auto high = static_cast<_input>(output_limits::max());
+    if (static_cast<long double>(high) > static_cast<long double>(output_limits::max()))
+      high = std::nextafter(high, _input(0));
+    return {static_cast<_input>(output_limits::lowest()), high};
+  }
+  else
+    return {
+      std::cmp_less   (input_limits::lowest(), output_limits::lowest()) ? static_cast<_input>(output_limits::lowest()) : input_limits::lowest(),
+      std::cmp_greater(input_limits::max   (), output_limits::max   ()) ? static_cast<_input>(output_limits::max   ()) : input_limits::max   ()};
+}
+template <typename _output, typename _input>
+constexpr _output saturate(_input value, _input low, _input high) noexcept
+{
+  if constexpr (std::is_floating_point_v<_input> && !std::is_floating_point_v<_output>)
+  {
+    if (value != value)
+      return _output(0);
+    if (high < value)
+      return std::numeric_limits<_output>::max();
+  }
+  return static_cast<_output>(value < low ? low : high < value ? high : value);
+}
+}
+
+// Sets the elements to the value.
+template <typename _type>
+void                      fill    (_type* data, std::size_t size, const _type& value)
+{
+#if defined(__GNUC__)
+  if constexpr (detail::vectorizable<_type>)
+  {
+    detail::dispatch([&] <std::size_t _bytes> () __attribute__((always_inline))
+    {
+      std::size_t i = 0;
+      if constexpr (_bytes != 0)
+      {
+        using vector = detail::vector_type<_type, _bytes>;
+        constexpr auto lanes     = _bytes / sizeof(_type);
+        const vector   broadcast = vector {} + value;
+        for (; i + lanes <= size; i += lanes)
+          std::memcpy(data + i, &broadcast, _bytes);
+      }
+      for (; i < size; ++i)
+        data[i] = value;
+    });
+    return;
+  }
+#endif
+  std::fill_n(data, size, value);
+}
+
+// Copies the elements of non-overlapping ranges. Trivially copyable elements are copied by memcpy, which the C
+// library already dispatches to the widest moves available.
+template <typename _type>
+void                      copy    (const _type* source, std::size_t size, _type* target)
+{
+  if constexpr (std::is_trivially_copyable_v<_type>)
+  {
+    if (size != 0)
+      std::memcpy(target, source, size * sizeof(_type));
+  }
+  else
+    std::copy_n(source, size, target);
+}
+
+// The index of the first pair of elements which do not compare equal as by operator==, or size if there is none.
+template <typename _type>
+std::size_t               mismatch(const _type* lhs, const _type* rhs, std::size_t size)
+{
+#if defined(__GNUC__)
+  if constexpr (detail::vectorizable<_type>)
+    return detail::dispatch([&] <std::size_t _bytes> () __attribute__((always_inline))
+    {
+      std::size_t i = 0;
+      if constexpr (_bytes != 0)
+      {
+        using vector      = detail::vector_type<_type        , _bytes>;
+        using mask_vector = detail::vector_type<std::uint64_t, _bytes>;
+        constexpr auto lanes = _bytes / sizeof(_type);
+        for (; i + lanes <= size; i += lanes)
+        {
+          vector left, right;
+          std::memcpy(&left , lhs + i, _bytes);
+          std::memcpy(&right, rhs + i, _bytes);
+
+          const auto    different = (mask_vector) (left != right);
+          std::uint64_t any       = 0;
+          for (std::size_t j = 0; j < _bytes / sizeof(std::uint64_t); ++j)
+            any |= different[j];
+          if (any != 0)
+            break; // Located by the scalar loop.
+        }
+      }
+      for (; i < size; ++i)
+        if (!(lhs[i] == rhs[i]))
+          return i;
+      return size;
+    });
+#endif
+  return static_cast<std::size_t>(std::mismatch(lhs, lhs + size, rhs).first - lhs);
+}
+
+// Whether the elements compare equal pairwise, as by operator==.
+template <typename _type>
+bool                      equal   (const _type* lhs, const _type* rhs, std::size_t size)
+{
+  return mismatch(lhs, rhs, size) == size;
+}
+
+// The smallest and largest elements, as by operator<. The range must not be empty, and its order is unspecified with
+// respect to NaNs.
+template <typename _type>
+std::pair<_type, _type>   minmax  (const _type* data, std::size_t size)
+{
+#if defined(__GNUC__)
+  if constexpr (detail::vectorizable<_type>)
+    return detail::dispatch([&] <std::size_t _bytes> () __attribute__((always_inline))
+    {
+      std::pair<_type, _type> result {data[0], data[0]};
+      std::size_t             i = 0;
+      if constexpr (_bytes != 0)
+      {
+        using vector = detail::vector_type<_type, _bytes>;
+        constexpr auto lanes = _bytes / sizeof(_type);
+        if (size >= lanes)
+        {
+          vector low, high;
+          std::memcpy(&low, data, _bytes);
+          high = low;
+          for (i = lanes; i + lanes <= size; i += lanes)
+          {
+            vector value;
+            std::memcpy(&value, data + i, _bytes);
+            low  = value < low  ? value : low ;
+            high = high  < value ? value : high;
+          }
+          for (std::size_t j = 0; j < lanes; ++j)
+          {
+            result.first  = low [j] < result.first  ? low [j] : result.first ;
+            result.second = result.second < high[j] ? high[j] : result.second;
+          }
+        }
+      }
+      for (; i < size; ++i)
+      {
+        result.first  = data[i] < result.first  ? data[i] : result.first ;
+        result.second = result.second < data[i] ? data[i] : result.second;
+      }
+      return result;
+    });
+#endif
+  const auto [minimum, maximum] = std::minmax_element(data, data + size);
+  return {*minimum, *maximum};
+}
+
+// Clamps the elements to [low, high], as by std::clamp.
+template <typename _type>
+void                      clamp   (_type* data, std::size_t size, const _type& low, const _type& high)
+{
+#if defined(__GNUC__)
+  if constexpr (detail::vectorizable<_type>)
+  {
+    detail::dispatch([&] <std::size_t _bytes> () __attribute__((always_inline))
+    {
+      std::size_t i = 0;
+      if constexpr (_bytes != 0)
+      {
+        using vector = detail::vector_type<_type, _bytes>;
+        constexpr auto lanes = _bytes / sizeof(_type);
+        for (; i + lanes <= size; i += lanes)
+        {
+          vector value;
+          std::memcpy(&value, data + i, _bytes);
+          value = value < low  ? low  : value;
+          value = high < value ? high : value;
+          std::memcpy(data + i, &value, _bytes);
+        }
+      }
+      for (; i < size; ++i)
+        data[i] = std::clamp(data[i], low, high);
+    });
+    return;
+  }
+#endif
+  for (std::size_t i = 0; i < size; ++i)
+    data[i] = std::clamp(data[i], low, high);
+}
+
+// Converts the elements as by static_cast, saturating to the output range for integer outputs, with NaN converting to
+// zero. Floating-point values are truncated toward zero.
+template <typename _output, typename _input>
+void                      convert (const _input* source, std::size_t size, _output* target)
+{
+#if defined(__GNUC__)
+  if constexpr (detail::vectorizable<_input> && detail::vectorizable<_output>)
+  {
+    const auto [low, high] = detail::saturation_bounds<_output, _input>();
+    detail::dispatch([&, low = low, high = high] <std::size_t _bytes> () __attribute__((always_inline))
+    {
+      std::size_t i = 0;
+      if constexpr (_bytes != 0)
+      {
+        constexpr auto lanes = _bytes / std::max(sizeof(_input), sizeof(_output));
+        using input_vector   = detail::vector_type<_input , lanes * sizeof(_input )>;
+        using output_vector  = detail::vector_type<_output, lanes * sizeof(_output)>;
+        for (; i + lanes <= size; i += lanes)
+        {
+          input_vector value;
+          std::memcpy(&value, source + i, sizeof(input_vector));
+          const auto original = value;
+          if constexpr (std::is_floating_point_v<_input> && !std::is_floating_point_v<_output>)
+            value = value == value ? value : _input(0);
+          if constexpr (!std::is_floating_point_v<_output>)
+          {
+            value = value < low  ? low  : value;
+            value = high < value ? high : value;
+          }
+          auto result = __builtin_convertvector(value, output_vector);
+          if constexpr (std::is_floating_point_v<_input> && !std::is_floating_point_v<_output>)
+          {
+            // Values above the bound saturate to the integer maximum, which the input type may not represent.
+            using mask_vector = detail::vector_type<std::make_signed_t<_output>, lanes * sizeof(_output)>;
+            const auto over   = __builtin_convertvector(original > high, mask_vector);
+            result = over ? output_vector {} + std::numeric_limits<_output>::max() : result;
+          }
+          std::memcpy(target + i, &result, sizeof(output_vector));
+        }
+      }
+      for (; i < size; ++i)
+        target[i] = detail::saturate<_output>(source[i], low, high);
+    });
+    return;
+  }
+#endif
+  for (std::size_t i = 0; i < size; ++i)
+    target[i] = static_cast<_output>(source[i]);
+}
+}
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <multi/third_party/mdspan.hpp>
+
+namespace multi
+{
+template <
+  typename    _tuple     ,
+  std::size_t _dimensions,
+  typename    _layout    = std::experimental::layout_right>
+class soa_vector;
+
+// Structure-of-arrays hyper-rectangular storage: one contiguous buffer per field of the tuple, sharing a mapping.
+// Element access returns tuples of references. Each field is accessible as an mdspan of its own.
+template <
+  typename... _types     ,
+  std::size_t _dimensions,
+  typename    _layout    >
+class soa_vector<std::tuple<_types...>, _dimensions, _layout>
+{
+public:
+  static_assert(sizeof...(_types) > 0, "A structure of arrays requires at least one field.");
+
+  using storage_type           = std::tuple<std::vector<_types>...>;
+  using extents_type           = std::experimental::dextents<_dimensions>;
+  using mapping_type           = typename _layout::template mapping<extents_type>;
+  template <std::size_t _index>
+  using field_type             = std::tuple_element_t<_index, std::tuple<_types...>>;
+  template <std::size_t _index>
+  using field_span_type        = std::experimental::mdspan<field_type<_index>, extents_type, _layout>;
+  template <std::size_t _index>
+  using const_field_span_type  = std::experimental::mdspan<const field_type<_index>, extents_type, _layout>;
+
+  using value_type             = std::tuple<_types...>;
+  using size_type              = std::size_t;
+  using difference_type        = std::ptrdiff_t;
+  using reference              = std::tuple<      _types&...>;
+  using const_reference        = std::tuple<const _types&...>;
+
+  using multi_size_type        = std::array<size_type, _dimensions>;
+
+  static constexpr size_type field_count = sizeof...(_types);
+
+  constexpr          soa_vector() = default;
+  constexpr explicit soa_vector(const multi_size_type& size, const value_type& value = value_type())
+  : mapping_(extents_type(size))
+  {
+    resize_storage(value, std::index_sequence_for<_types...>());
+  }
+
+  constexpr          soa_vector(const soa_vector&  that) = default;
+  constexpr          soa_vector(      soa_vector&& temp) noexcept
+  : storage_(std::move(temp.storage_)), mapping_(std::exchange(temp.mapping_, mapping_type()))
+  {
+
+  }
+  constexpr         ~soa_vector() = default;
+
+  constexpr soa_vector&            operator=    (const soa_vector&  that) = default;
+  constexpr soa_vector&            operator=    (      soa_vector&& temp) noexcept
+  {
+    if (this != &temp)
+    {
+      storage_ = std::move(temp.storage_);
+      mapping_ = std::exchange(temp.mapping_, mapping_type());
+    }
+    return *this;
+  }
+
+  // Element access.
+
+  constexpr reference              at           (const multi_size_type& position)
+  {
+    check_bounds(position);
+    return operator()(position);
+  }
+  constexpr const_reference        at           (const multi_size_type& position) const
+  {
+    check_bounds(position);
+    return operator()(position);
+  }
+  template <typename... _positions>
+  constexpr reference              at           (_positions...          position)
+  {
+    return at(multi_size_type {static_cast<size_type>(position)...});
+  }
+  template <typename... _positions>
+  constexpr const_reference        at           (_positions...          position) const
+  {
+    return at(multi_size_type {static_cast<size_type>(position)...});
+  }
+
+  constexpr reference              operator[]   (const multi_size_type& position)
+  {
+    return operator()(position);
+  }
+  constexpr const_reference        operator[]   (const multi_size_type& position) const
+  {
+    return operator()(position);
+  }
+
+  constexpr reference              operator()   (const multi_size_type& position)
+  {
+    return element(std::apply(mapping_, position));
+  }
+  constexpr const_reference        operator()   (const multi_size_type& position) const
+  {
+    return element(std::apply(mapping_, position));
+  }
+  template <typename... _positions>
+  constexpr reference              operator()   (_positions...          position)
+  {
+    return element(mapping_(position...));
+  }
+  template <typename... _positions>
+  constexpr const_reference        operator()   (_positions...          position) const
+  {
+    return element(mapping_(position...));
+  }
+
+  // Field access.
+
+  template <std::size_t _index>
+  constexpr field_type<_index>*            data () noexcept
+  {
+    return std::get<_index>(storage_).data();
+  }
+  template <std::size_t _index>
+  constexpr const field_type<_index>*      data () const noexcept
+  {
+    return std::get<_index>(storage_).data();
+  }
+  template <std::size_t _index>
+  constexpr field_span_type<_index>        field() noexcept
+  {
+    return field_span_type<_index>(data<_index>(), mapping_);
+  }
+  template <std::size_t _index>
+  constexpr const_field_span_type<_index>  field() const noexcept
+  {
+    return const_field_span_type<_index>(data<_index>(), mapping_);
+  }
+
+  // Capacity.
+
+  constexpr bool                   empty        () const noexcept
+  {
+    return size() == 0;
+  }
+  constexpr size_type              size         () const noexcept
+  {
+    return std::get<0>(storage_).size();
+  }
+  constexpr multi_size_type        dimensions   () const noexcept
+  {
+    multi_size_type result;
+    for (size_type i = 0; i < _dimensions; ++i)
+      result[i] = mapping_.extents().extent(i);
+    return result;
+  }
+
+  // Modifiers (resizing does not preserve the multidimensional positions of the elements, as in vector).
+
+  constexpr void                   clear        () noexcept
+  {
+    clear_storage();
+    mapping_ = mapping_type();
+  }
+  constexpr void                   resize       (const multi_size_type& size, const value_type& value = value_type())
+  {
+    mapping_ = mapping_type(extents_type(size));
+    resize_storage(value, std::index_sequence_for<_types...>());
+  }
+
+  constexpr void                   swap         (soa_vector& that) noexcept
+  {
+    std::swap(storage_, that.storage_);
+    std::swap(mapping_, that.mapping_);
+  }
+
+  // Member access.
+
+  constexpr const storage_type&    storage      () const noexcept
+  {
+    return storage_;
+  }
+  constexpr const mapping_type&    mapping      () const noexcept
+  {
+    return mapping_;
+  }
+
+protected:
+  constexpr reference              element      (size_type index)
+  {
+    return std::apply([&] (auto&... storage) { return reference(storage[index]...); }, storage_);
+  }
+  constexpr const_reference        element      (size_type index) const
+  {
+    return std::apply([&] (const auto&... storage) { return const_reference(storage[index]...); }, storage_);
+  }
+
+  constexpr void                   clear_storage()
+  {
+    std::apply([ ] (auto&... storage) { (storage.clear(), ...); }, storage_);
+  }
+  template <std::size_t... _indices>
+  constexpr void                   resize_storage(const value_type& value, std::index_sequence<_indices...>)
+  {
+    const auto size = mapping_.required_span_size();
+    (std::get<_indices>(storage_).resize(size, std::get<_indices>(value)), ...);
+  }
+
+  constexpr void                   check_bounds (const multi_size_type& position) const
+  {
+    for (size_type i = 0; i < _dimensions; ++i)
+      if (position[i] >= mapping_.extents().extent(i))
+        throw std::out_of_range("multi::soa_vector::at");
+  }
+
+  storage_type storage_ ;
+  mapping_type mapping_ ;
+};
+
+// Non-member functions.
+
+template <typename _tuple, std::size_t _dimensions, typename _layout>
+constexpr bool operator== (
+  const soa_vector<_tuple, _dimensions, _layout>& lhs,
+  const soa_vector<_tuple, _dimensions, _layout>& rhs)
+{
+  return lhs.storage() == rhs.storage() && lhs.mapping() == rhs.mapping();
+}
+
+template <typename _tuple, std::size_t _dimensions, typename _layout>
+constexpr void swap(
+  soa_vector<_tuple, _dimensions, _layout>& lhs,
+  soa_vector<_tuple, _dimensions, _layout>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+}
@@ -0,0 +1,365 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <multi/array.hpp>
+#include <multi/execution.hpp>
+#include <multi/nested_for.hpp>
+
+namespace multi
+{
+namespace detail
+{
+template <std::size_t _size, typename _sequence>
+struct uniform_dimensions;
+template <std::size_t _size, std::size_t... _indices>
+struct uniform_dimensions<_size, std::index_sequence<_indices...>>
+{
+  using type = dimensions<(static_cast<void>(_indices), _size)...>;
+};
+
+template <typename _multi_size_type>
+struct multi_size_hash
+{
+  constexpr std::size_t operator()(const _multi_size_type& value) const noexcept
+  {
+    std::size_t result = 0;
+    for (const auto& element : value)
+      result ^= std::hash<typename _multi_size_type::value_type>()(element) + 0x9e3779b97f4a7c15ull + (result << 6) + (result >> 2);
+    return result;
+  }
+};
+}
+
+// Hyper-rectangular storage which allocates dense blocks of _block_size^_dimensions elements on demand.
+// Reads from unallocated blocks return the background value. Non-const element access allocates the enclosing block.
+template <
+  typename    _type      ,
+  std::size_t _dimensions,
+  std::size_t _block_size = 8>
+class sparse_vector
+{
+public:
+  using block_type             = array<_type, typename detail::uniform_dimensions<_block_size, std::make_index_sequence<_dimensions>>::type>;
+
+  using value_type             = _type;
+  using size_type              = std::size_t;
+  using difference_type        = std::ptrdiff_t;
+  using reference              = value_type&;
+  using const_reference        = const value_type&;
+
+  using multi_size_type        = std::array<size_type, _dimensions>;
+  using block_map_type         = std::unordered_map<multi_size_type, std::unique_ptr<block_type>, detail::multi_size_hash<multi_size_type>>;
+
+                     sparse_vector() = default;
+  explicit           sparse_vector(const multi_size_type& size, const_reference background = value_type())
+  : dimensions_(size), background_(background)
+  {
+
+  }
+
+                     sparse_vector(const sparse_vector&  that)
+  : dimensions_(that.dimensions_), background_(that.background_)
+  {
+    blocks_.reserve(that.blocks_.size());
+    for (const auto& [position, block] : that.blocks_)
+      blocks_.emplace(position, std::make_unique<block_type>(*block));
+  }
+                     sparse_vector(      sparse_vector&& temp) noexcept
+  : dimensions_(std::exchange(temp.dimensions_, {})), background_(std::move(temp.background_)), blocks_(std::move(temp.blocks_))
+  {
+    temp.blocks_.clear();
+  }
+
+                    ~sparse_vector() = default;
+
+  sparse_vector&                   operator=    (const sparse_vector&  that)
+  {
+    if (this != &that)
+    {
+      sparse_vector copy(that);
+      swap(copy);
+    }
+    return *this;
+  }
+  sparse_vector&                   operator=    (      sparse_vector&& temp) noexcept
+  {
+    if (this != &temp)
+    {
+      dimensions_ = std::exchange(temp.dimensions_, {});
+      background_ = std::move(temp.background_);
+      blocks_     = std::move(temp.blocks_);
+
+      temp.blocks_.clear();
+    }
+    return *this;
+  }
+
+  // Element access.
+
+  reference                        at           (const multi_size_type& position)
+  {
+    check_bounds(position);
+    return operator()(position);
+  }
+  const_reference                  at           (const multi_size_type& position) const
+  {
+    check_bounds(position);
+    return operator()(position);
+  }
+  template <typename... _positions>
+  reference                        at           (_positions...          position)
+  {
+    return at(multi_size_type {static_cast<size_type>(position)...});
+  }
+  template <typename... _positions>
+  const_reference                  at           (_positions...          position) const
+  {
+    return at(multi_size_type {static_cast<size_type>(position)...});
+  }
+
+  reference                        operator[]   (const multi_size_type& position)
+  {
+    return operator()(position);
+  }
+  const_reference                  operator[]   (const multi_size_type& position) const
+  {
+    return operator()(position);
+  }
+
+  reference                        operator()   (const multi_size_type& position)
+  {
+    return activate(block_position(position))(block_offset(position));
+  }
+  const_reference                  operator()   (const multi_size_type& position) const
+  {
+    return value(position);
+  }
+  template <typename... _positions>
+  reference                        operator()   (_positions...          position)
+  {
+    return operator()(multi_size_type {static_cast<size_type>(position)...});
+  }
+  template <typename... _positions>
+  const_reference                  operator()   (_positions...          position) const
+  {
+    return operator()(multi_size_type {static_cast<size_type>(position)...});
+  }
+
+  // Reads without allocating, also on non-const instances.
+  const_reference                  value        (const multi_size_type& position) const
+  {
+    const auto block = find_block(block_position(position));
+    return block ? (*block)(block_offset(position)) : background_;
+  }
+  constexpr const_reference        background   () const noexcept
+  {
+    return background_;
+  }
+
+  // Block access.
+
+  bool                             active       (const multi_size_type& position) const
+  {
+    return blocks_.contains(block_position(position));
+  }
+
+  block_type*                      find_block   (const multi_size_type& block_position)
+  {
+    const auto iterator = blocks_.find(block_position);
+    return iterator != blocks_.end() ? iterator->second.get() : nullptr;
+  }
+  const block_type*                find_block   (const multi_size_type& block_position) const
+  {
+    const auto iterator = blocks_.find(block_position);
+    return iterator != blocks_.end() ? iterator->second.get() : nullptr;
+  }
+  block_type&                      activate     (const multi_size_type& block_position)
+  {
+    auto& block = blocks_[block_position];
+    if (!block)
+      block = std::make_unique<block_type>(background_);
+    return *block;
+  }
+  void                             deactivate   (const multi_size_type& block_position)
+  {
+    blocks_.erase(block_position);
+  }
+
+  // Calls function(block_position, block) for each active block.
+  template <typename _function>
+  void                             for_each_block(_function&& function)
+  {
+    for (auto& [position, block] : blocks_)
+      function(position, *block);
+  }
+  template <typename _function>
+  void                             for_each_block(_function&& function) const
+  {
+    for (const auto& [position, block] : blocks_)
+      function(position, static_cast<const block_type&>(*block));
+  }
+  template <typename _execution_policy, typename _function>
+  void                             for_each_block(_execution_policy&& policy, _function&& function)
+  {
+    std::vector<std::pair<const multi_size_type*, block_type*>> entries;
+    entries.reserve(blocks_.size());
+    for (auto& [position, block] : blocks_)
+      entries.emplace_back(&position, block.get());
+
+    for_each_index(policy, entries.size(), [&] (const size_type i)
+    {
+      function(*entries[i].first, *entries[i].second);
+    });
+  }
+
+  // Capacity.
+
+  constexpr bool                   empty        () const noexcept
+  {
+    return size() == 0;
+  }
+  constexpr size_type              size         () const noexcept
+  {
+    return linear_size(dimensions_);
+  }
+  constexpr multi_size_type        dimensions   () const noexcept
+  {
+    return dimensions_;
+  }
+  size_type                        block_count  () const noexcept
+  {
+    return blocks_.size();
+  }
+  size_type                        active_size  () const noexcept
+  {
+    return blocks_.size() * block_type::dimensions_type::linear_size();
+  }
+  static constexpr multi_size_type block_dimensions() noexcept
+  {
+    return block_type::dimensions_type::sizes();
+  }
+
+  // Modifiers.
+
+  void                             clear        () noexcept
+  {
+    blocks_.clear();
+  }
+  // Drops the blocks which lie entirely outside the new dimensions, and resets the elements of the retained blocks which
+  // lie outside them to the background value, so that they do not reappear when growing again.
+  void                             resize       (const multi_size_type& size)
+  {
+    dimensions_ = size;
+    std::erase_if(blocks_, [&] (const auto& entry)
+    {
+      for (size_type i = 0; i < _dimensions; ++i)
+        if (entry.first[i] * _block_size >= dimensions_[i])
+          return true;
+      return false;
+    });
+
+    for (auto& [position, block] : blocks_)
+      for (size_type i = 0; i < _dimensions; ++i)
+      {
+        // The part of the block beyond the new extent of axis i.
+        multi_size_type begin {}, end = block_dimensions();
+        if ((position[i] + 1) * _block_size <= dimensions_[i])
+          continue;
+        begin[i] = dimensions_[i] - position[i] * _block_size;
+        nested_for(begin, end, [&] (const multi_size_type& offset)
+        {
+          (*block)(offset) = background_;
+        });
+      }
+  }
+  // Deactivates the blocks whose elements all equal the background value.
+  void                             prune        ()
+  {
+    prune(execution::seq);
+  }
+  template <typename _execution_policy>
+  void                             prune        (_execution_policy&& policy)
+  {
+    std::vector<typename block_map_type::iterator> entries;
+    entries.reserve(blocks_.size());
+    for (auto iterator = blocks_.begin(); iterator != blocks_.end(); ++iterator)
+      entries.push_back(iterator);
+
+    std::vector<char> uniform(entries.size());
+    for_each_index(policy, entries.size(), [&] (const size_type i)
+    {
+      const auto& block = *entries[i]->second;
+      uniform[i] = std::all_of(block.begin(), block.end(), [&] (const auto& element) { return element == background_; });
+    });
+
+    for (size_type i = 0; i < entries.size(); ++i)
+      if (uniform[i])
+        blocks_.erase(entries[i]);
+  }
+
+  void                             swap         (sparse_vector& that) noexcept
+  {
+    std::swap(dimensions_, that.dimensions_);
+    std::swap(background_, that.background_);
+    std::swap(blocks_    , that.blocks_    );
+  }
+
+  // Member access.
+
+  const block_map_type&            blocks       () const noexcept
+  {
+    return blocks_;
+  }
+
+  static constexpr multi_size_type block_position(const multi_size_type& position) noexcept
+  {
+    multi_size_type result;
+    for (size_type i = 0; i < _dimensions; ++i)
+      result[i] = position[i] / _block_size;
+    return result;
+  }
+  static constexpr multi_size_type block_offset  (const multi_size_type& position) noexcept
+  {
+    multi_size_type result;
+    for (size_type i = 0; i < _dimensions; ++i)
+      result[i] = position[i] % _block_size;
+    return result;
+  }
+
+protected:
+  static constexpr size_type       linear_size  (const multi_size_type& size)
+  {
+    return std::accumulate(size.begin(), size.end(), static_cast<size_type>(1), std::multiplies<size_type>());
+  }
+  constexpr void                   check_bounds (const multi_size_type& position) const
+  {
+    for (size_type i = 0; i < _dimensions; ++i)
+      if (position[i] >= dimensions_[i])
+        throw std::out_of_range("multi::sparse_vector::at");
+  }
+
+  multi_size_type dimensions_ {};
+  value_type      background_ {};
+  block_map_type  blocks_     ;
+};
+
+// Non-member functions.
+
+template <typename _type, std::size_t _dimensions, std::size_t _block_size>
+void swap(
+  sparse_vector<_type, _dimensions, _block_size>& lhs,
+  sparse_vector<_type, _dimensions, _block_size>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+}
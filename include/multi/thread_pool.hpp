@@ -0,0 +1,276 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <multi/execution.hpp>
+
+namespace multi
+{
+// Half-open N-D index range [begin, end).
+template <std::size_t _dimensions>
+struct box
+{
+  using multi_size_type = std::array<std::size_t, _dimensions>;
+
+  constexpr std::size_t size () const noexcept
+  {
+    std::size_t result = 1;
+    for (std::size_t i = 0; i < _dimensions; ++i)
+      result *= end[i] > begin[i] ? end[i] - begin[i] : 0;
+    return result;
+  }
+  constexpr bool        empty() const noexcept
+  {
+    return size() == 0;
+  }
+  // Halves the box along its longest axis, keeping the lower half and returning the upper one.
+  constexpr box         split() noexcept
+  {
+    std::size_t axis = 0;
+    for (std::size_t i = 1; i < _dimensions; ++i)
+      if (end[i] - begin[i] > end[axis] - begin[axis])
+        axis = i;
+
+    box upper         = *this;
+    end[axis]         = begin[axis] + (end[axis] - begin[axis]) / 2;
+    upper.begin[axis] = end[axis];
+    return upper;
+  }
+
+  multi_size_type begin {};
+  multi_size_type end   {};
+};
+
+// Work-stealing pool. Each worker owns a deque, popping its own tasks LIFO and stealing others' FIFO. Threads calling
+// parallel_for run the tasks of their own queue, then block until the work completes, so nested parallel_for calls from
+// tasks are allowed.
+class thread_pool
+{
+public:
+  explicit thread_pool(std::size_t thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 2) - 1)
+  : queues_(thread_count + 1)
+  {
+    for (auto& queue : queues_)
+      queue = std::make_unique<task_queue>();
+    threads_.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i)
+      threads_.emplace_back([this, i] { work(i); });
+  }
+  thread_pool(const thread_pool&  that) = delete;
+  thread_pool(      thread_pool&& temp) = delete;
+  ~thread_pool()
+  {
+    {
+      std::lock_guard lock(sleep_mutex_);
+      stop_ = true;
+    }
+    sleep_condition_.notify_all();
+    for (auto& thread : threads_)
+      thread.join();
+  }
+
+  thread_pool& operator=(const thread_pool&  that) = delete;
+  thread_pool& operator=(      thread_pool&& temp) = delete;
+
+  std::size_t  thread_count() const noexcept
+  {
+    return threads_.size();
+  }
+
+  // Calls function(leaf) for disjoint leaves covering the range, recursively halving boxes larger than grain elements.
+  // The first exception thrown by the function is rethrown once all leaves are processed.
+  template <std::size_t _dimensions, typename _function>
+  void         parallel_for(const box<_dimensions>& range, std::size_t grain, _function&& function)
+  {
+    if (range.empty())
+      return;
+
+    job<_dimensions, std::remove_reference_t<_function>> root {this, &function, std::max<std::size_t>(grain, 1), std::make_shared<job_state>()};
+    root.state->remaining = range.size();
+    root(range);
+
+    const auto index = local_index();
+    while (root.state->remaining.load(std::memory_order_acquire) != 0)
+      if (!try_run(index, false))
+        break;
+    {
+      std::unique_lock lock(root.state->mutex);
+      root.state->done.wait(lock, [&] { return root.state->remaining.load(std::memory_order_acquire) == 0; });
+    }
+
+    if (root.state->exception)
+      std::rethrow_exception(root.state->exception);
+  }
+
+protected:
+  using task = std::function<void()>;
+
+  struct alignas(64) task_queue
+  {
+    std::mutex       mutex;
+    std::deque<task> tasks;
+  };
+  struct job_state
+  {
+    std::atomic<std::size_t> remaining {0};
+    std::mutex               mutex     ;
+    std::condition_variable  done      ;
+    std::exception_ptr       exception ;
+  };
+
+  template <std::size_t _dimensions, typename _function>
+  struct job
+  {
+    void operator()(box<_dimensions> range) const
+    {
+      while (range.size() > grain)
+        pool->push([job = *this, upper = range.split()] { job(upper); });
+
+      try
+      {
+        (*function)(static_cast<const box<_dimensions>&>(range));
+      }
+      catch (...)
+      {
+        std::lock_guard lock(state->mutex);
+        if (!state->exception)
+          state->exception = std::current_exception();
+      }
+      if (state->remaining.fetch_sub(range.size(), std::memory_order_acq_rel) == range.size())
+      {
+        std::lock_guard lock(state->mutex);
+        state->done.notify_all();
+      }
+    }
+
+    thread_pool*               pool    ;
+    _function*                 function;
+    std::size_t                grain   ;
+    std::shared_ptr<job_state> state   ;
+  };
+
+  // Index of the calling thread's queue. Threads outside the pool share the last one.
+  std::size_t  local_index () const noexcept
+  {
+    return current().first == this ? current().second : threads_.size();
+  }
+  static std::pair<const thread_pool*, std::size_t>& current() noexcept
+  {
+    thread_local std::pair<const thread_pool*, std::size_t> value {nullptr, 0};
+    return value;
+  }
+
+  void         push        (task&& task)
+  {
+    auto& queue = *queues_[local_index()];
+    {
+      std::lock_guard lock(queue.mutex);
+      queue.tasks.push_back(std::move(task));
+      queued_.fetch_add(1, std::memory_order_release);
+    }
+    {
+      std::lock_guard lock(sleep_mutex_);
+    }
+    sleep_condition_.notify_one();
+  }
+  // Runs a task of the queue at index, or with steal, of any other queue. Returns false if none was found.
+  bool         try_run     (std::size_t index, bool steal = true)
+  {
+    task task;
+    for (std::size_t i = 0; i < (steal ? queues_.size() : 1) && !task; ++i)
+    {
+      auto& queue = *queues_[(index + i) % queues_.size()];
+      std::lock_guard lock(queue.mutex);
+      if (queue.tasks.empty())
+        continue;
+
+      if (i == 0)
+      {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      }
+      else
+      {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+      queued_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    if (!task)
+      return false;
+
+    task();
+    return true;
+  }
+  void         work        (std::size_t index)
+  {
+    current() = {this, index};
+    while (true)
+    {
+      if (try_run(index))
+        continue;
+
+      std::unique_lock lock(sleep_mutex_);
+      sleep_condition_.wait(lock, [&] { return stop_ || queued_.load(std::memory_order_acquire) > 0; });
+      if (stop_ && queued_.load(std::memory_order_acquire) == 0)
+        return;
+    }
+  }
+
+  std::vector<std::unique_ptr<task_queue>> queues_         ;
+  std::vector<std::thread>                 threads_        ;
+  std::atomic<std::size_t>                 queued_         {0};
+  std::mutex                               sleep_mutex_    ;
+  std::condition_variable                  sleep_condition_;
+  bool                                     stop_           = false;
+};
+
+inline thread_pool& default_thread_pool()
+{
+  static thread_pool pool;
+  return pool;
+}
+
+namespace execution
+{
+// Schedules the library's parallel algorithms on a work-stealing pool. Unlike parallel_policy, indices are load
+// balanced dynamically and no index-to-thread assignment is guaranteed.
+struct pool_policy
+{
+  thread_pool* pool  = &default_thread_pool();
+  std::size_t  grain = 0; // Zero selects size / (8 * concurrency).
+};
+
+// Declared in this namespace to be found by argument-dependent lookup from the algorithms.
+inline std::size_t concurrency   (const pool_policy& policy) noexcept
+{
+  return policy.pool->thread_count() + 1;
+}
+template <typename _function>
+void               for_each_index(const pool_policy& policy, std::size_t size, _function&& function)
+{
+  const auto grain = policy.grain != 0 ? policy.grain : std::max<std::size_t>(size / (8 * concurrency(policy)), 1);
+  policy.pool->parallel_for(box<1> {{0}, {size}}, grain, [&] (const box<1>& range)
+  {
+    for (auto i = range.begin[0]; i < range.end[0]; ++i)
+      function(i);
+  });
+}
+}
+
+using execution::concurrency;
+using execution::for_each_index;
+}
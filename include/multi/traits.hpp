@@ -0,0 +1,20 @@
+#pragma once
+
+namespace multi
+{
+// The result of const element access through a span with the given reference type: a const lvalue reference for
+// lvalue references, the value type for proxy references.
+template <typename _reference>
+struct const_reference_of
+{
+  using type = typename _reference::value_type;
+};
+template <typename _type>
+struct const_reference_of<_type&>
+{
+  using type = const _type&;
+};
+
+template <typename _reference>
+using const_reference_of_t = typename const_reference_of<_reference>::type;
+}
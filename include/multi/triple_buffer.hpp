@@ -0,0 +1,258 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include <multi/vector.hpp>
+
+namespace multi
+{
+// Lock-free single-producer, multiple-consumer hand-off of vectors. The writer fills a free slot and publishes it as the
+// latest epoch; readers acquire the latest published slot and keep it alive, whatever the writer publishes meanwhile,
+// until they release it. With three slots and one reader, the writer never fails to acquire; additional readers
+// holding distinct epochs require additional slots. No operation blocks, and no element is copied.
+template <
+  typename    _type      ,
+  std::size_t _dimensions,
+  typename    _layout    = std::experimental::layout_right,
+  typename    _accessor  = std::experimental::default_accessor<_type>,
+  typename    _allocator = std::allocator<_type>>
+class triple_buffer
+{
+public:
+  using vector_type     = vector<_type, _dimensions, _layout, _accessor, _allocator>;
+  using value_type      = typename vector_type::value_type;
+  using size_type       = typename vector_type::size_type;
+  using multi_size_type = typename vector_type::multi_size_type;
+  using epoch_type      = std::uint64_t;
+
+  class write_handle
+  {
+  public:
+    constexpr          write_handle() noexcept = default;
+    constexpr          write_handle(const write_handle&  that) = delete;
+    constexpr          write_handle(      write_handle&& temp) noexcept
+    : owner_(std::exchange(temp.owner_, nullptr)), slot_(temp.slot_)
+    {
+
+    }
+             ~write_handle()
+    {
+      reset();
+    }
+
+    constexpr write_handle& operator= (const write_handle&  that) = delete;
+    write_handle&           operator= (      write_handle&& temp) noexcept
+    {
+      if (this != &temp)
+      {
+        reset();
+        owner_ = std::exchange(temp.owner_, nullptr);
+        slot_  = temp.slot_;
+      }
+      return *this;
+    }
+
+    constexpr vector_type&  operator* () const noexcept
+    {
+      return owner_->slots_[slot_].vector;
+    }
+    constexpr vector_type*  operator->() const noexcept
+    {
+      return &owner_->slots_[slot_].vector;
+    }
+    constexpr explicit      operator bool() const noexcept
+    {
+      return owner_ != nullptr;
+    }
+
+    // Returns the slot unpublished.
+    void                    reset     () noexcept
+    {
+      if (owner_)
+        std::exchange(owner_, nullptr)->slots_[slot_].state.store(0, std::memory_order_release);
+    }
+
+  protected:
+    friend class triple_buffer;
+
+    constexpr write_handle(triple_buffer* owner, size_type slot) noexcept
+    : owner_(owner), slot_(slot)
+    {
+
+    }
+
+    triple_buffer* owner_ = nullptr;
+    size_type      slot_  = 0;
+  };
+
+  class read_handle
+  {
+  public:
+    constexpr          read_handle() noexcept = default;
+    constexpr          read_handle(const read_handle&  that) = delete;
+    constexpr          read_handle(      read_handle&& temp) noexcept
+    : owner_(std::exchange(temp.owner_, nullptr)), slot_(temp.slot_)
+    {
+
+    }
+             ~read_handle()
+    {
+      reset();
+    }
+
+    constexpr read_handle&   operator= (const read_handle&  that) = delete;
+    read_handle&             operator= (      read_handle&& temp) noexcept
+    {
+      if (this != &temp)
+      {
+        reset();
+        owner_ = std::exchange(temp.owner_, nullptr);
+        slot_  = temp.slot_;
+      }
+      return *this;
+    }
+
+    constexpr const vector_type& operator* () const noexcept
+    {
+      return owner_->slots_[slot_].vector;
+    }
+    constexpr const vector_type* operator->() const noexcept
+    {
+      return &owner_->slots_[slot_].vector;
+    }
+    constexpr explicit           operator bool() const noexcept
+    {
+      return owner_ != nullptr;
+    }
+    constexpr epoch_type         epoch     () const noexcept
+    {
+      return owner_->slots_[slot_].epoch;
+    }
+
+    void                         reset     () noexcept
+    {
+      if (owner_)
+        std::exchange(owner_, nullptr)->slots_[slot_].state.fetch_sub(1, std::memory_order_release);
+    }
+
+  protected:
+    friend class triple_buffer;
+
+    constexpr read_handle(const triple_buffer* owner, size_type slot) noexcept
+    : owner_(owner), slot_(slot)
+    {
+
+    }
+
+    const triple_buffer* owner_ = nullptr;
+    size_type            slot_  = 0;
+  };
+
+  // Every slot holds a vector of the given size, filled with the value. Nothing is published initially.
+  explicit triple_buffer(const multi_size_type& size, const value_type& value = value_type(), size_type slot_count = 3)
+  : slot_count_(std::max<size_type>(slot_count, 2)), slots_(std::make_unique<slot[]>(slot_count_))
+  {
+    for (size_type i = 0; i < slot_count_; ++i)
+    {
+      if constexpr (_dimensions == 1)
+        slots_[i].vector = vector_type(size[0], value);
+      else
+        slots_[i].vector = vector_type(size, value);
+    }
+  }
+  triple_buffer(const triple_buffer&  that) = delete;
+  triple_buffer(      triple_buffer&& temp) = delete;
+  ~triple_buffer() = default;
+
+  triple_buffer&                   operator=    (const triple_buffer&  that) = delete;
+  triple_buffer&                   operator=    (      triple_buffer&& temp) = delete;
+
+  // Claims a slot which is neither the latest nor read. Empty if readers hold all other slots. Single writer only.
+  write_handle                     acquire_write()
+  {
+    const auto latest = latest_.load(std::memory_order_acquire);
+    for (size_type i = 1; i <= slot_count_; ++i)
+    {
+      const auto index    = (next_write_ + i) % slot_count_;
+      auto       expected = std::uint32_t(0);
+      if (index != latest && slots_[index].state.compare_exchange_strong(expected, writing, std::memory_order_acquire, std::memory_order_relaxed))
+      {
+        next_write_ = index;
+        return write_handle(this, index);
+      }
+    }
+    return write_handle();
+  }
+  // Makes the written slot the latest epoch. Returns the epoch, or 0 without effect if the handle is empty (e.g. a
+  // failed acquire_write()) or belongs to another buffer.
+  epoch_type                       publish      (write_handle&& handle)
+  {
+    if (handle.owner_ != this)
+      return 0;
+
+    auto& slot = slots_[handle.slot_];
+    slot.epoch = ++epoch_;
+    slot.state.store(0, std::memory_order_release);
+    latest_.store(handle.slot_, std::memory_order_release);
+    handle.owner_ = nullptr;
+    return slot.epoch;
+  }
+
+  // Acquires the latest published slot. Empty if nothing is published yet.
+  read_handle                      acquire_latest_read() const
+  {
+    while (true)
+    {
+      const auto index = latest_.load(std::memory_order_acquire);
+      if (index == none)
+        return read_handle();
+
+      auto& state    = slots_[index].state;
+      auto  expected = state.load(std::memory_order_relaxed);
+      while (expected != writing)
+        if (state.compare_exchange_weak(expected, expected + 1, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+          // Between the load of latest_ and the increment, the writer may have published a newer slot, then taken
+          // this one and abandoned it midway. Only a slot still latest once held is known to be intact.
+          if (latest_.load(std::memory_order_acquire) == index)
+            return read_handle(this, index);
+          state.fetch_sub(1, std::memory_order_release);
+          break;
+        }
+      // The writer reclaimed the slot after publishing a newer one; retry with the latest.
+    }
+  }
+
+  epoch_type                       epoch        () const noexcept
+  {
+    return epoch_.load(std::memory_order_acquire);
+  }
+  constexpr size_type              slot_count   () const noexcept
+  {
+    return slot_count_;
+  }
+
+protected:
+  static constexpr std::uint32_t writing = std::numeric_limits<std::uint32_t>::max();
+  static constexpr size_type     none    = std::numeric_limits<size_type>::max();
+
+  struct slot
+  {
+    vector_type                        vector;
+    epoch_type                         epoch  = 0;
+    mutable std::atomic<std::uint32_t> state  {0}; // Reader count, or writing.
+  };
+
+  size_type               slot_count_ ;
+  std::unique_ptr<slot[]> slots_      ;
+  std::atomic<size_type>  latest_     {none};
+  std::atomic<epoch_type> epoch_      {0};
+  size_type               next_write_ = 0;
+};
+}
@@ -1,29 +1,39 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <initializer_list>
 #include <memory>
-#include <numeric>
+#include <memory_resource>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include <multi/ndindex.hpp>
+#include <multi/simd.hpp>
 #include <multi/third_party/mdspan.hpp>
+#include <multi/traits.hpp>
 
 namespace multi
 {
+// The extents may mix static and dynamic extents, in which case only the dynamic ones are passed on construction and
+// resizing (see mixed_vector). Static extents fold into compile-time strides. Vectors of fully static extents always
+// hold their elements, which are value-initialized on default construction and clear().
 template <
   typename    _type      ,
   std::size_t _dimensions,
   typename    _layout    = std::experimental::layout_right,
   typename    _accessor  = std::experimental::default_accessor<_type>,
-  typename    _allocator = std::allocator<_type>>
+  typename    _allocator = std::allocator<_type>,
+  typename    _extents   = std::experimental::dextents<_dimensions>>
 class vector
 {
 public:
+  static_assert(_extents::rank() == _dimensions, "The rank of the extents must match the dimensions.");
+
   using storage_type           = std::vector<_type, _allocator>;
-  using span_type              = std::experimental::mdspan<_type, std::experimental::dextents<_dimensions>, _layout, _accessor>;
+  using span_type              = std::experimental::mdspan<_type, _extents, _layout, _accessor>;
 
   using value_type             = typename storage_type::value_type;
   using allocator_type         = typename storage_type::allocator_type;
@@ -37,61 +47,74 @@ public:
   using const_iterator         = typename storage_type::const_iterator;
   using reverse_iterator       = typename storage_type::reverse_iterator;
   using const_reverse_iterator = typename storage_type::const_reverse_iterator;
+
+  using accessor_type          = _accessor;
+  using span_reference         = typename span_type::reference;
+  using span_const_reference   = const_reference_of_t<span_reference>;
+  using indexed_type           = indexed_range<span_type>;
+  using const_indexed_type     = indexed_range<span_type, span_const_reference>;
   
+  using extents_type           = _extents;
   using multi_size_type        = std::array<size_type, _dimensions>;
+  using dynamic_size_type      = std::array<size_type, extents_type::rank_dynamic()>;
+
+  constexpr          vector() noexcept(noexcept(allocator_type())) requires (_extents::rank_dynamic() != 0) = default;
+  constexpr          vector()                                        requires (_extents::rank_dynamic() == 0)
+  : vector(allocator_type())
+  {
 
-  constexpr          vector() noexcept(noexcept(allocator_type())) = default;
-  constexpr explicit vector(const allocator_type& alloc) noexcept
-  : storage_(alloc)
+  }
+  constexpr explicit vector(const allocator_type& alloc) noexcept(_extents::rank_dynamic() != 0)
+  : storage_(linear_size(dynamic_size_type {}), alloc), span_(storage_.data(), dynamic_size_type {})
   {
 
   }
   
-  template <                          size_type _d = _dimensions, typename std::enable_if_t<_d == 1,  size_type> = 0>
+  template <                          size_type _d = _dimensions, typename std::enable_if_t<_d == 1 && _extents::rank_dynamic() == 1, size_type> = 0>
   constexpr          vector(size_type size, const_reference value = value_type(), const allocator_type& alloc = allocator_type())
   : storage_(size, value, alloc), span_(storage_.data(), storage_.size())
   {
 
   }
-  template <                          size_type _d = _dimensions, typename std::enable_if_t<_d == 1,  size_type> = 0>
+  template <                          size_type _d = _dimensions, typename std::enable_if_t<_d == 1 && _extents::rank_dynamic() == 1, size_type> = 0>
   constexpr explicit vector(size_type size,                                       const allocator_type& alloc = allocator_type())
   : storage_(size, alloc),        span_(storage_.data(), storage_.size())
   {
 
   }
-  template <typename _input_iterator, size_type _d = _dimensions, typename std::enable_if_t<_d == 1,  size_type> = 0>
+  template <typename _input_iterator, size_type _d = _dimensions, typename std::enable_if_t<_d == 1 && _extents::rank_dynamic() == 1, size_type> = 0>
   constexpr          vector(_input_iterator first, _input_iterator last,            const allocator_type& alloc = allocator_type())
   : storage_(first, last, alloc), span_(storage_.data(), storage_.size())
   {
 
   }
-  template <                          size_type _d = _dimensions, typename std::enable_if_t<_d == 1,  size_type> = 0>
+  template <                          size_type _d = _dimensions, typename std::enable_if_t<_d == 1 && _extents::rank_dynamic() == 1, size_type> = 0>
   constexpr          vector(std::initializer_list<value_type> list,               const allocator_type& alloc = allocator_type())
   : storage_(list, alloc),        span_(storage_.data(), storage_.size())
   {
 
   }
   
-  template <                          size_type _d = _dimensions, typename std::enable_if_t<(_d > 1), size_type> = 0>
-  constexpr          vector(const multi_size_type& size, const_reference value = value_type(),      const allocator_type& alloc = allocator_type())
+  template <                          size_type _d = _dimensions, typename std::enable_if_t<_d != 1 || _extents::rank_dynamic() != 1, size_type> = 0>
+  constexpr          vector(const dynamic_size_type& size, const_reference value = value_type(),      const allocator_type& alloc = allocator_type())
   : storage_(linear_size(size), value, alloc), span_(storage_.data(), size)
   {
 
   }
-  template <                          size_type _d = _dimensions, typename std::enable_if_t<(_d > 1), size_type> = 0>
-  constexpr explicit vector(const multi_size_type& size,                                            const allocator_type& alloc = allocator_type())
+  template <                          size_type _d = _dimensions, typename std::enable_if_t<_d != 1 || _extents::rank_dynamic() != 1, size_type> = 0>
+  constexpr explicit vector(const dynamic_size_type& size,                                            const allocator_type& alloc = allocator_type())
   : storage_(linear_size(size), alloc),        span_(storage_.data(), size)
   {
 
   }
-  template <typename _input_iterator, size_type _d = _dimensions, typename std::enable_if_t<(_d > 1), size_type> = 0>
-  constexpr          vector(const multi_size_type& size, _input_iterator first, _input_iterator last, const allocator_type& alloc = allocator_type())
+  template <typename _input_iterator, size_type _d = _dimensions, typename std::enable_if_t<_d != 1 || _extents::rank_dynamic() != 1, size_type> = 0>
+  constexpr          vector(const dynamic_size_type& size, _input_iterator first, _input_iterator last, const allocator_type& alloc = allocator_type())
   : storage_(linear_size(size), alloc),        span_(storage_.data(), size)
   {
     std::copy(first, last, storage_.begin());
   }
-  template <                          size_type _d = _dimensions, typename std::enable_if_t<(_d > 1), size_type> = 0>
-  constexpr          vector(const multi_size_type& size, std::initializer_list<value_type> list,    const allocator_type& alloc = allocator_type())
+  template <                          size_type _d = _dimensions, typename std::enable_if_t<_d != 1 || _extents::rank_dynamic() != 1, size_type> = 0>
+  constexpr          vector(const dynamic_size_type& size, std::initializer_list<value_type> list,    const allocator_type& alloc = allocator_type())
   : storage_(linear_size(size), alloc),        span_(storage_.data(), size)
   {
     std::copy(list.begin(), list.end(), storage_.begin());
@@ -107,17 +130,15 @@ public:
   {
 
   }
-  constexpr          vector(      vector&& temp) noexcept
+  constexpr          vector(      vector&& temp) noexcept(_extents::rank_dynamic() != 0)
   : storage_(std::move(temp.storage_)),        span_(storage_.data(), temp.span_.mapping(), temp.span_.accessor())
   {
-    temp.storage_ = {};
-    temp.span_    = {};
+    temp.clear();
   }
   constexpr          vector(      vector&& temp, const allocator_type& alloc)
   : storage_(std::move(temp.storage_), alloc), span_(storage_.data(), temp.span_.mapping(), temp.span_.accessor())
   {
-    temp.storage_ = {};
-    temp.span_    = {};
+    temp.clear();
   }
   
   constexpr         ~vector() = default;
@@ -131,71 +152,82 @@ public:
     }
     return *this;
   }
-  constexpr vector&                operator=    (      vector&& temp) noexcept
+  // Allocators propagate as in std::vector. Moved-from containers are cleared but keep their allocators.
+  constexpr vector&                operator=    (      vector&& temp) noexcept(_extents::rank_dynamic() != 0 && (
+    std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value ||
+    std::allocator_traits<allocator_type>::is_always_equal::value))
   {
     if (this != &temp)
     {
       storage_      = std::move(temp.storage_);
       span_         = span_type(storage_.data(), temp.span_.mapping(), temp.span_.accessor());
 
-      temp.storage_ = {};
-      temp.span_    = {};
+      temp.clear();
     }
     return *this;
   }
   
-  template <size_type _d = _dimensions, typename = std::enable_if_t<_d == 1>>
+  template <size_type _d = _dimensions, typename = std::enable_if_t<_d == 1 && _extents::rank_dynamic() == 1>>
   constexpr vector&                operator=    (std::initializer_list<_type> list)
   {
     storage_ = list;
-    span_    = span_type(storage_.data(), storage_.size());
+    update_span(storage_.size());
     return *this;
   }
 
-  template <                          size_type _d = _dimensions, typename = std::enable_if_t<_d == 1>>
+  template <                          size_type _d = _dimensions, typename = std::enable_if_t<_d == 1 && _extents::rank_dynamic() == 1>>
   constexpr void                   assign       (size_type size, const_reference value)
   {
     storage_.assign(size, value);
-    span_ = span_type(storage_.data(), size);
+    update_span(size);
   }
-  template <typename _input_iterator, size_type _d = _dimensions, typename = std::enable_if_t<_d == 1>>
+  template <typename _input_iterator, size_type _d = _dimensions, typename = std::enable_if_t<_d == 1 && _extents::rank_dynamic() == 1>>
   constexpr void                   assign       (_input_iterator first, _input_iterator last)
   {
     storage_.assign(first, last);
-    span_ = span_type(storage_.data(), storage_.size());
+    update_span(storage_.size());
   }
-  template <                          size_type _d = _dimensions, typename = std::enable_if_t<_d == 1>>
+  template <                          size_type _d = _dimensions, typename = std::enable_if_t<_d == 1 && _extents::rank_dynamic() == 1>>
   constexpr void                   assign       (std::initializer_list<_type> list)
   {
     storage_.assign(list);
-    span_ = span_type(storage_.data(), storage_.size());
+    update_span(storage_.size());
   }
   
-  template <                          size_type _d = _dimensions, typename = std::enable_if_t<(_d > 1)>>
-  constexpr void                   assign       (const multi_size_type& size, const_reference value)
+  template <                          size_type _d = _dimensions, typename = std::enable_if_t<_d != 1 || _extents::rank_dynamic() != 1>>
+  constexpr void                   assign       (const dynamic_size_type& size, const_reference value)
   {
     storage_.assign(linear_size(size), value);
-    span_ = span_type(storage_.data(), size);
+    update_span(size);
   }
-  template <typename _input_iterator, size_type _d = _dimensions, typename = std::enable_if_t<(_d > 1)>>
-  constexpr void                   assign       (const multi_size_type& size, _input_iterator first, _input_iterator last)
+  template <typename _input_iterator, size_type _d = _dimensions, typename = std::enable_if_t<_d != 1 || _extents::rank_dynamic() != 1>>
+  constexpr void                   assign       (const dynamic_size_type& size, _input_iterator first, _input_iterator last)
   {
     storage_.resize(linear_size(size));
     std::copy(first, last, storage_.begin());
-    span_ = span_type(storage_.data(), size);
+    update_span(size);
   }
-  template <                          size_type _d = _dimensions, typename = std::enable_if_t<(_d > 1)>>
-  constexpr void                   assign       (const multi_size_type& size, std::initializer_list<_type> list)
+  template <                          size_type _d = _dimensions, typename = std::enable_if_t<_d != 1 || _extents::rank_dynamic() != 1>>
+  constexpr void                   assign       (const dynamic_size_type& size, std::initializer_list<_type> list)
   {
     storage_.resize(linear_size(size));
     std::copy(list.begin(), list.end(), storage_.begin());
-    span_ = span_type(storage_.data(), size);
+    update_span(size);
   }
 
   constexpr allocator_type         get_allocator() const noexcept
   {
     return storage_.get_allocator();
   }
+  constexpr accessor_type          get_accessor () const noexcept
+  {
+    return span_.accessor();
+  }
+  // The accessor is retained by assign, resize and clear.
+  constexpr void                   set_accessor (const accessor_type& accessor)
+  {
+    span_ = span_type(storage_.data(), span_.mapping(), accessor);
+  }
 
   // Element access.
 
@@ -207,21 +239,21 @@ public:
   {
     return storage_.at(position);
   }
-  constexpr reference              at           (const multi_size_type& position)
+  constexpr span_reference         at           (const multi_size_type& position)
   {
     return span_(position);
   }
-  constexpr const_reference        at           (const multi_size_type& position) const
+  constexpr span_const_reference   at           (const multi_size_type& position) const
   {
     return span_(position);
   }
   template <typename... _positions>
-  constexpr reference              at           (_positions...          position)
+  constexpr span_reference         at           (_positions...          position)
   {
     return span_(position...);
   }
   template <typename... _positions>
-  constexpr const_reference        at           (_positions...          position) const
+  constexpr span_const_reference   at           (_positions...          position) const
   {
     return span_(position...);
   }
@@ -234,30 +266,30 @@ public:
   {
     return storage_[position];
   }
-  constexpr reference              operator[]   (const multi_size_type& position)
+  constexpr span_reference         operator[]   (const multi_size_type& position)
   {
     return span_(position);
   }
-  constexpr const_reference        operator[]   (const multi_size_type& position) const
+  constexpr span_const_reference   operator[]   (const multi_size_type& position) const
   {
     return span_(position);
   }
   
-  constexpr reference              operator()   (const multi_size_type& position)
+  constexpr span_reference         operator()   (const multi_size_type& position)
   {
     return span_(position);
   }
-  constexpr const_reference        operator()   (const multi_size_type& position) const
+  constexpr span_const_reference   operator()   (const multi_size_type& position) const
   {
     return span_(position);
   }
   template <typename... _positions>
-  constexpr reference              operator()   (_positions...          position)
+  constexpr span_reference         operator()   (_positions...          position)
   {
     return span_(position...);
   }
   template <typename... _positions>
-  constexpr const_reference        operator()   (_positions...          position) const
+  constexpr span_const_reference   operator()   (_positions...          position) const
   {
     return span_(position...);
   }
@@ -343,6 +375,16 @@ public:
     return storage_.crend  ();
   }
 
+  // Elements with their positions, in memory order. Increments avoid divisions.
+  constexpr indexed_type           indexed      () noexcept
+  {
+    return indexed_type      (span_);
+  }
+  constexpr const_indexed_type     indexed      () const noexcept
+  {
+    return const_indexed_type(span_);
+  }
+
   // Capacity.
 
   constexpr bool                   empty        () const noexcept
@@ -368,6 +410,11 @@ public:
   {
     storage_.reserve(capacity);
   }
+  template <size_type _d = _dimensions, typename = std::enable_if_t<_d != 1 || _extents::rank_dynamic() != 1>>
+  constexpr void                   reserve      (const dynamic_size_type& size)
+  {
+    storage_.reserve(linear_size(size));
+  }
   constexpr size_type              capacity     () const noexcept
   {
     return storage_.capacity();
@@ -379,42 +426,55 @@ public:
   
   // Modifiers (hyper-rectangular storages have no correspondents for insert, emplace, erase, push_back, emplace_back, pop_back).
 
-  constexpr void                   clear        () noexcept
+  constexpr void                   clear        () noexcept(_extents::rank_dynamic() != 0)
   {
-    storage_.clear();
-    span_ = {};
+    if constexpr (_extents::rank_dynamic() == 0)
+      storage_.assign(linear_size(dynamic_size_type {}), value_type());
+    else
+      storage_.clear();
+    update_span(dynamic_size_type {});
   } 
   
-  template <size_type _d = _dimensions, typename = std::enable_if_t<_d == 1>>
+  template <size_type _d = _dimensions, typename = std::enable_if_t<_d == 1 && _extents::rank_dynamic() == 1>>
   constexpr void                   resize       (size_type          size)
   {
     storage_.resize(size);
-    span_ = span_type(storage_.data(), size);
+    update_span(size);
   }
-  template <size_type _d = _dimensions, typename = std::enable_if_t<_d == 1>>
+  template <size_type _d = _dimensions, typename = std::enable_if_t<_d == 1 && _extents::rank_dynamic() == 1>>
   constexpr void                   resize       (size_type          size, const_reference value)
   {
     storage_.resize(size, value);
-    span_ = span_type(storage_.data(), size);
+    update_span(size);
   }
   
-  template <size_type _d = _dimensions, typename = std::enable_if_t<(_d > 1)>>
-  constexpr void                   resize       (const multi_size_type& size)
+  template <size_type _d = _dimensions, typename = std::enable_if_t<_d != 1 || _extents::rank_dynamic() != 1>>
+  constexpr void                   resize       (const dynamic_size_type& size)
   {
     storage_.resize(linear_size(size));
-    span_ = span_type(storage_.data(), size);
+    update_span(size);
   }
-  template <size_type _d = _dimensions, typename = std::enable_if_t<(_d > 1)>>
-  constexpr void                   resize       (const multi_size_type& size, const_reference value)
+  template <size_type _d = _dimensions, typename = std::enable_if_t<_d != 1 || _extents::rank_dynamic() != 1>>
+  constexpr void                   resize       (const dynamic_size_type& size, const_reference value)
   {
     storage_.resize(linear_size(size), value);
-    span_ = span_type(storage_.data(), size);
+    update_span(size);
   }
   
+  constexpr void                   fill         (const_reference value)
+  {
+    if constexpr (simd::detail::vectorizable<_type>)
+      if (!std::is_constant_evaluated())
+      {
+        simd::fill(storage_.data(), storage_.size(), value);
+        return;
+      }
+    std::fill(storage_.begin(), storage_.end(), value);
+  }
   constexpr void                   swap         (vector& that) noexcept
   {
-    std::swap(storage_, that.storage_);
-    std::swap(span_   , that.span_   );
+    storage_.swap(that.storage_);
+    std::swap(span_, that.span_);
   }
 
   // Member access.
@@ -429,9 +489,18 @@ public:
   }
 
 protected:
-  static constexpr size_type       linear_size  (const multi_size_type& size)
+  static constexpr size_type       linear_size  (const dynamic_size_type& size)
+  {
+    const extents_type extents(size);
+    size_type          result = 1;
+    for (size_type i = 0; i < extents_type::rank(); ++i)
+      result *= extents.extent(i);
+    return result;
+  }
+  template <typename _size_type>
+  constexpr void                   update_span  (const _size_type&      size)
   {
-    return std::accumulate(size.begin(), size.end(), static_cast<size_type>(1), std::multiplies<size_type>());
+    span_ = span_type(storage_.data(), typename span_type::mapping_type(typename span_type::extents_type(size)), span_.accessor());
   }
 
   storage_type storage_;
@@ -440,26 +509,58 @@ protected:
 
 // Non-member functions (hyper-rectangular storages have no correspondents for erase, erase_if).
 
-template <typename _type, std::size_t _dimensions, typename _layout, typename _accessor, typename _allocator>
+template <typename _type, std::size_t _dimensions, typename _layout, typename _accessor, typename _allocator, typename _extents>
 constexpr bool operator== (
-  const vector<_type, _dimensions, _layout, _accessor, _allocator>& lhs, 
-  const vector<_type, _dimensions, _layout, _accessor, _allocator>& rhs)
+  const vector<_type, _dimensions, _layout, _accessor, _allocator, _extents>& lhs, 
+  const vector<_type, _dimensions, _layout, _accessor, _allocator, _extents>& rhs)
 {
-  return lhs.storage() == rhs.storage() && lhs.span().mapping() == rhs.span().mapping();
+  if (!(lhs.span().mapping() == rhs.span().mapping()) || lhs.size() != rhs.size())
+    return false;
+  if constexpr (simd::detail::vectorizable<_type>)
+    if (!std::is_constant_evaluated())
+      return simd::equal(lhs.data(), rhs.data(), lhs.size());
+  return lhs.storage() == rhs.storage();
 }
-template <typename _type, std::size_t _dimensions, typename _layout, typename _accessor, typename _allocator>
+template <typename _type, std::size_t _dimensions, typename _layout, typename _accessor, typename _allocator, typename _extents>
 constexpr auto operator<=>(
-  const vector<_type, _dimensions, _layout, _accessor, _allocator>& lhs, 
-  const vector<_type, _dimensions, _layout, _accessor, _allocator>& rhs)
+  const vector<_type, _dimensions, _layout, _accessor, _allocator, _extents>& lhs, 
+  const vector<_type, _dimensions, _layout, _accessor, _allocator, _extents>& rhs)
 {
+  if constexpr (simd::detail::vectorizable<_type>)
+    if (!std::is_constant_evaluated())
+    {
+      using ordering = decltype(lhs.storage() <=> rhs.storage());
+      const auto size  = std::min(lhs.size(), rhs.size());
+      const auto index = simd::mismatch(lhs.data(), rhs.data(), size);
+      return index < size ? ordering(lhs.data()[index] <=> rhs.data()[index]) : ordering(lhs.size() <=> rhs.size());
+    }
   return lhs.storage() <=> rhs.storage();
 }
 
-template <typename _type, std::size_t _dimensions, typename _layout, typename _accessor, typename _allocator>
+template <typename _type, std::size_t _dimensions, typename _layout, typename _accessor, typename _allocator, typename _extents>
 constexpr void swap(
-        vector<_type, _dimensions, _layout, _accessor, _allocator>& lhs, 
-        vector<_type, _dimensions, _layout, _accessor, _allocator>& rhs) noexcept
+        vector<_type, _dimensions, _layout, _accessor, _allocator, _extents>& lhs, 
+        vector<_type, _dimensions, _layout, _accessor, _allocator, _extents>& rhs) noexcept
 {
   lhs.swap(rhs);
 }
-}
\ No newline at end of file
+
+// Vector of mixed static and dynamic extents, e.g. mixed_vector<float, extents<dynamic_extent, 4>> for RGBA rows.
+template <
+  typename _type      ,
+  typename _extents   ,
+  typename _layout    = std::experimental::layout_right,
+  typename _accessor  = std::experimental::default_accessor<_type>,
+  typename _allocator = std::allocator<_type>>
+using mixed_vector = vector<_type, _extents::rank(), _layout, _accessor, _allocator, _extents>;
+
+namespace pmr
+{
+template <
+  typename    _type      ,
+  std::size_t _dimensions,
+  typename    _layout    = std::experimental::layout_right,
+  typename    _accessor  = std::experimental::default_accessor<_type>>
+using vector = multi::vector<_type, _dimensions, _layout, _accessor, std::pmr::polymorphic_allocator<_type>>;
+}
+}
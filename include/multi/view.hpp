@@ -0,0 +1,208 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+
+#include <multi/ndindex.hpp>
+#include <multi/third_party/mdspan.hpp>
+
+namespace multi
+{
+namespace detail
+{
+// Containers (and views) whose storage a view of the element type, rank and layout can refer to.
+template <typename _container, typename _type, std::size_t _dimensions, typename _layout>
+concept viewable = requires (_container& container)
+{
+  { container.data() } -> std::convertible_to<_type*>;
+  requires std::remove_cvref_t<decltype(container.span())>::rank() == _dimensions;
+  requires std::is_same_v<typename std::remove_cvref_t<decltype(container.span())>::layout_type, _layout>;
+  requires std::is_same_v<typename std::remove_cvref_t<decltype(container.span())>::accessor_type, std::experimental::default_accessor<typename std::remove_cvref_t<decltype(container.span())>::element_type>>;
+};
+}
+
+// Non-owning view of hyper-rectangular storage at a pointer, e.g. a foreign buffer or a container, with the element
+// access of the containers. vector, array and views convert to it implicitly, so that functions taking views accept
+// any of them without copies. Linear access and iterators are provided for contiguous layouts.
+template <
+  typename    _type      ,
+  std::size_t _dimensions,
+  typename    _layout    = std::experimental::layout_right>
+class view
+{
+public:
+  using span_type              = std::experimental::mdspan<_type, std::experimental::dextents<_dimensions>, _layout>;
+  using mapping_type           = typename span_type::mapping_type;
+  using extents_type           = typename span_type::extents_type;
+
+  using element_type           = _type;
+  using value_type             = std::remove_cv_t<_type>;
+  using size_type              = std::size_t;
+  using difference_type        = std::ptrdiff_t;
+  using reference              = _type&;
+  using const_reference        = const _type&;
+  using pointer                = _type*;
+  using const_pointer          = const _type*;
+  using iterator               = pointer;
+  using reverse_iterator       = std::reverse_iterator<iterator>;
+  using indexed_type           = indexed_range<span_type>;
+
+  using multi_size_type        = std::array<size_type, _dimensions>;
+
+  constexpr          view() noexcept = default;
+  constexpr          view(pointer data, const multi_size_type& size) noexcept
+  : span_(data, mapping_type(extents_type(size)))
+  {
+
+  }
+  template <size_type _d = _dimensions, typename = std::enable_if_t<_d == 1>>
+  constexpr          view(pointer data, size_type size) noexcept
+  : span_(data, mapping_type(extents_type(size)))
+  {
+
+  }
+  constexpr          view(pointer data, const mapping_type& mapping) noexcept
+  : span_(data, mapping)
+  {
+
+  }
+  constexpr          view(const span_type& span) noexcept
+  : span_(span)
+  {
+
+  }
+  template <typename _container>
+    requires (!std::is_same_v<std::remove_cv_t<_container>, view> && detail::viewable<_container, _type, _dimensions, _layout>)
+  constexpr          view(_container& container) noexcept
+  : span_(container.data(), mapping_type(container.span().mapping()))
+  {
+
+  }
+
+  // Element access.
+
+  constexpr reference              at           (size_type              position) const requires (mapping_type::is_always_contiguous())
+  {
+    if (position >= size())
+      throw std::out_of_range("multi::view::at");
+    return data()[position];
+  }
+  constexpr reference              at           (const multi_size_type& position) const
+  {
+    for (size_type i = 0; i < _dimensions; ++i)
+      if (position[i] >= span_.extent(i))
+        throw std::out_of_range("multi::view::at");
+    return span_(position);
+  }
+  template <typename... _positions>
+    requires (sizeof...(_positions) == _dimensions && _dimensions != 1)
+  constexpr reference              at           (_positions...          position) const
+  {
+    return at(multi_size_type {static_cast<size_type>(position)...});
+  }
+
+  constexpr reference              operator[]   (size_type              position) const requires (mapping_type::is_always_contiguous())
+  {
+    return data()[position];
+  }
+  constexpr reference              operator[]   (const multi_size_type& position) const
+  {
+    return span_(position);
+  }
+
+  constexpr reference              operator()   (const multi_size_type& position) const
+  {
+    return span_(position);
+  }
+  template <typename... _positions>
+  constexpr reference              operator()   (_positions...          position) const
+  {
+    return span_(position...);
+  }
+
+  constexpr reference              front        () const requires (mapping_type::is_always_contiguous())
+  {
+    return data()[0];
+  }
+  constexpr reference              back         () const requires (mapping_type::is_always_contiguous())
+  {
+    return data()[size() - 1];
+  }
+
+  constexpr pointer                data         () const noexcept
+  {
+    return span_.data();
+  }
+
+  // Iterators.
+
+  constexpr iterator               begin        () const noexcept requires (mapping_type::is_always_contiguous())
+  {
+    return data();
+  }
+  constexpr iterator               end          () const noexcept requires (mapping_type::is_always_contiguous())
+  {
+    return data() + size();
+  }
+  constexpr reverse_iterator       rbegin       () const noexcept requires (mapping_type::is_always_contiguous())
+  {
+    return reverse_iterator(end());
+  }
+  constexpr reverse_iterator       rend         () const noexcept requires (mapping_type::is_always_contiguous())
+  {
+    return reverse_iterator(begin());
+  }
+
+  // Elements with their positions, in memory order.
+  constexpr indexed_type           indexed      () const noexcept
+  {
+    return indexed_type(span_);
+  }
+
+  // Capacity.
+
+  constexpr bool                   empty        () const noexcept
+  {
+    return size() == 0;
+  }
+  constexpr size_type              size         () const noexcept
+  {
+    return span_.size();
+  }
+  constexpr multi_size_type        dimensions   () const noexcept
+  {
+    multi_size_type result;
+    for (size_type i = 0; i < _dimensions; ++i)
+      result[i] = span_.extent(i);
+    return result;
+  }
+
+  // Member access.
+
+  constexpr const span_type&       span         () const noexcept
+  {
+    return span_;
+  }
+
+protected:
+  span_type span_;
+};
+
+template <typename _container>
+view(_container& container) -> view<
+  std::remove_pointer_t<decltype(container.data())>,
+  std::remove_cvref_t<decltype(container.span())>::rank(),
+  typename std::remove_cvref_t<decltype(container.span())>::layout_type>;
+}
+
+namespace std::ranges
+{
+// Views do not own their elements, so that references to them outlive temporary views.
+template <typename _type, std::size_t _dimensions, typename _layout>
+inline constexpr bool enable_borrowed_range<multi::view<_type, _dimensions, _layout>> = true;
+}
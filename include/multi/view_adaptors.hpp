@@ -0,0 +1,314 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <multi/algorithm.hpp>
+#include <multi/execution.hpp>
+#include <multi/traits.hpp>
+#include <multi/vector.hpp>
+
+// Lazy N-D views which compute their elements on access from containers, spans or other lazy views, without allocation.
+// They are indexed as mdspans, and are evaluated by evaluate() or copy() in a single pass, in which the composed
+// accesses inline into one loop nest. Operands are held by value: spans of containers, which must outlive the view, and
+// lazy views. Elements of const containers are read-only through the views.
+namespace multi
+{
+struct lazy_view_tag
+{
+
+};
+
+// Common interface of the lazy views. Derived classes provide extent(axis) and operator()(const multi_size_type&).
+template <typename _derived, std::size_t _dimensions>
+class lazy_view : public lazy_view_tag
+{
+public:
+  using size_type       = std::size_t;
+  using multi_size_type = std::array<size_type, _dimensions>;
+
+  static constexpr size_type rank         () noexcept
+  {
+    return _dimensions;
+  }
+  constexpr size_type        size         () const
+  {
+    size_type result = 1;
+    for (size_type i = 0; i < _dimensions; ++i)
+      result *= derived().extent(i);
+    return result;
+  }
+  constexpr multi_size_type  dimensions   () const
+  {
+    multi_size_type result;
+    for (size_type i = 0; i < _dimensions; ++i)
+      result[i] = derived().extent(i);
+    return result;
+  }
+
+  template <typename... _positions>
+    requires (sizeof...(_positions) == _dimensions && (std::is_convertible_v<_positions, size_type> && ...))
+  constexpr decltype(auto)   operator()   (_positions... position) const
+  {
+    return derived()(multi_size_type {static_cast<size_type>(position)...});
+  }
+  constexpr decltype(auto)   operator[]   (const multi_size_type& position) const
+  {
+    return derived()(position);
+  }
+
+protected:
+  constexpr const _derived&  derived      () const noexcept
+  {
+    return static_cast<const _derived&>(*this);
+  }
+};
+
+// Elements function(operands(position)...) of operands of equal extents.
+template <typename _function, typename _operand, typename... _operands>
+class transform_view : public lazy_view<transform_view<_function, _operand, _operands...>, _operand::rank()>
+{
+public:
+  using base_type       = lazy_view<transform_view, _operand::rank()>;
+  using size_type       = typename base_type::size_type;
+  using multi_size_type = typename base_type::multi_size_type;
+  using reference       = std::invoke_result_t<const _function&, decltype(std::declval<const _operand&>()(std::declval<const multi_size_type&>())), decltype(std::declval<const _operands&>()(std::declval<const multi_size_type&>()))...>;
+  using element_type    = std::remove_reference_t<reference>;
+  using value_type      = std::remove_cvref_t<reference>;
+
+  using base_type::operator();
+
+  constexpr transform_view() = default;
+  constexpr transform_view(const _function& function, const _operand& operand, const _operands&... operands)
+  : function_(function), operands_(operand, operands...)
+  {
+    static_assert(((_operands::rank() == _operand::rank()) && ...), "The operands must have the same rank.");
+    for (size_type i = 0; i < _operand::rank(); ++i)
+      if (((static_cast<size_type>(operands.extent(i)) != static_cast<size_type>(operand.extent(i))) || ...))
+        throw std::invalid_argument("multi::transform_view");
+  }
+
+  constexpr size_type       extent       (size_type axis) const
+  {
+    return std::get<0>(operands_).extent(axis);
+  }
+  constexpr reference       operator()   (const multi_size_type& position) const
+  {
+    return std::apply([&] (const auto&... operands) -> reference
+    {
+      return std::invoke(function_, operands(position)...);
+    }, operands_);
+  }
+
+protected:
+  _function                         function_;
+  std::tuple<_operand, _operands...> operands_;
+};
+
+// Every step-th element along each axis, starting with the first.
+template <typename _operand>
+class strided_view : public lazy_view<strided_view<_operand>, _operand::rank()>
+{
+public:
+  using base_type       = lazy_view<strided_view, _operand::rank()>;
+  using size_type       = typename base_type::size_type;
+  using multi_size_type = typename base_type::multi_size_type;
+  using reference       = decltype(std::declval<const _operand&>()(std::declval<const multi_size_type&>()));
+  using element_type    = std::remove_reference_t<reference>;
+  using value_type      = std::remove_cvref_t<reference>;
+
+  using base_type::operator();
+
+  constexpr strided_view() = default;
+  constexpr strided_view(const _operand& operand, const multi_size_type& steps)
+  : operand_(operand), steps_(steps)
+  {
+    for (const auto step : steps_)
+      if (step == 0)
+        throw std::invalid_argument("multi::strided_view");
+  }
+
+  constexpr size_type       extent       (size_type axis) const
+  {
+    return (static_cast<size_type>(operand_.extent(axis)) + steps_[axis] - 1) / steps_[axis];
+  }
+  constexpr reference       operator()   (multi_size_type position) const
+  {
+    for (size_type i = 0; i < _operand::rank(); ++i)
+      position[i] *= steps_[i];
+    return operand_(position);
+  }
+
+protected:
+  _operand        operand_;
+  multi_size_type steps_  {};
+};
+
+// The elements in reverse order along the selected axes.
+template <typename _operand>
+class reversed_view : public lazy_view<reversed_view<_operand>, _operand::rank()>
+{
+public:
+  using base_type       = lazy_view<reversed_view, _operand::rank()>;
+  using size_type       = typename base_type::size_type;
+  using multi_size_type = typename base_type::multi_size_type;
+  using axes_type       = std::array<bool, _operand::rank()>;
+  using reference       = decltype(std::declval<const _operand&>()(std::declval<const multi_size_type&>()));
+  using element_type    = std::remove_reference_t<reference>;
+  using value_type      = std::remove_cvref_t<reference>;
+
+  using base_type::operator();
+
+  constexpr reversed_view() = default;
+  constexpr reversed_view(const _operand& operand, const axes_type& axes)
+  : operand_(operand), axes_(axes)
+  {
+
+  }
+
+  constexpr size_type       extent       (size_type axis) const
+  {
+    return static_cast<size_type>(operand_.extent(axis));
+  }
+  constexpr reference       operator()   (multi_size_type position) const
+  {
+    for (size_type i = 0; i < _operand::rank(); ++i)
+      if (axes_[i])
+        position[i] = extent(i) - 1 - position[i];
+    return operand_(position);
+  }
+
+protected:
+  _operand  operand_;
+  axes_type axes_    {};
+};
+
+namespace detail
+{
+struct zipper
+{
+  template <typename... _references>
+  constexpr std::tuple<_references...> operator()(_references&&... references) const
+  {
+    return std::tuple<_references...>(std::forward<_references>(references)...);
+  }
+};
+struct as_const
+{
+  template <typename _reference>
+  constexpr const_reference_of_t<_reference> operator()(_reference&& reference) const
+  {
+    return std::forward<_reference>(reference);
+  }
+};
+
+// Lazy views are held by value, containers by their spans and spans as they are. Const containers, whose spans still
+// refer to mutable elements, are read through spans of const elements, or views of const references for accessors
+// other than the default.
+template <typename _operand>
+constexpr auto as_operand(_operand&& operand)
+{
+  if constexpr (std::is_base_of_v<lazy_view_tag, std::remove_cvref_t<_operand>>)
+    return std::forward<_operand>(operand);
+  else if constexpr (const_container<_operand> && requires { operand.span(); })
+  {
+    using span_type = std::remove_cvref_t<decltype(operand.span())>;
+    if constexpr (std::is_same_v<typename span_type::accessor_type, std::experimental::default_accessor<typename span_type::element_type>>)
+      return std::experimental::mdspan<const typename span_type::element_type, typename span_type::extents_type, typename span_type::layout_type>(operand.span().data(), operand.span().mapping());
+    else
+      return transform_view<as_const, span_type>(as_const(), operand.span());
+  }
+  else if constexpr (requires { operand.span(); })
+    return operand.span();
+  else
+    return std::forward<_operand>(operand);
+}
+template <typename _operand>
+using operand_t = decltype(as_operand(std::declval<_operand>()));
+
+// Operands the views can refer to: lazy views, spans, and containers which outlive the view, i.e. lvalues or views
+// borrowing their elements. The spans of temporary containers would dangle as soon as the full-expression ends.
+template <typename _operand>
+concept operand = std::is_lvalue_reference_v<_operand> || !requires (_operand& operand) { operand.span(); } ||
+  std::is_base_of_v<lazy_view_tag, std::remove_cvref_t<_operand>> || std::ranges::enable_borrowed_range<std::remove_cvref_t<_operand>>;
+
+// Values of the element references, e.g. of the tuples of references of zip.
+template <typename _reference>
+struct value_of
+{
+  using type = std::remove_cvref_t<_reference>;
+};
+template <typename... _references>
+struct value_of<std::tuple<_references...>>
+{
+  using type = std::tuple<typename value_of<std::remove_cvref_t<_references>>::type...>;
+};
+}
+
+// Elements function(operands(position)...), e.g. transform(std::minus(), a, b) for a - b.
+template <typename _function, typename _operand, typename... _operands>
+  requires (detail::operand<_operand> && (detail::operand<_operands> && ...))
+constexpr auto transform(_function&& function, _operand&& operand, _operands&&... operands)
+{
+  return transform_view<std::decay_t<_function>, detail::operand_t<_operand>, detail::operand_t<_operands>...>(
+    std::forward<_function>(function), detail::as_operand(std::forward<_operand>(operand)), detail::as_operand(std::forward<_operands>(operands))...);
+}
+// Tuples of the operands' elements (references to the elements of containers and spans, const for const containers).
+template <typename _operand, typename... _operands>
+  requires (detail::operand<_operand> && (detail::operand<_operands> && ...))
+constexpr auto zip      (_operand&& operand, _operands&&... operands)
+{
+  return transform(detail::zipper(), std::forward<_operand>(operand), std::forward<_operands>(operands)...);
+}
+template <typename _operand>
+  requires detail::operand<_operand>
+constexpr auto stride   (_operand&& operand, const std::array<std::size_t, detail::operand_t<_operand>::rank()>& steps)
+{
+  return strided_view<detail::operand_t<_operand>>(detail::as_operand(std::forward<_operand>(operand)), steps);
+}
+template <typename _operand>
+  requires detail::operand<_operand>
+constexpr auto reverse  (_operand&& operand, std::size_t axis)
+{
+  std::array<bool, detail::operand_t<_operand>::rank()> axes {};
+  axes.at(axis) = true;
+  return reversed_view<detail::operand_t<_operand>>(detail::as_operand(std::forward<_operand>(operand)), axes);
+}
+// Reverses every axis.
+template <typename _operand>
+  requires detail::operand<_operand>
+constexpr auto flip     (_operand&& operand)
+{
+  std::array<bool, detail::operand_t<_operand>::rank()> axes;
+  axes.fill(true);
+  return reversed_view<detail::operand_t<_operand>>(detail::as_operand(std::forward<_operand>(operand)), axes);
+}
+
+// Evaluates a lazy view (or copies a span) into a vector of its extents, of the values of its elements.
+template <typename _view, typename _execution_policy = const execution::sequenced_policy&>
+auto evaluate(const _view& view, _execution_policy&& policy = execution::seq)
+{
+  const auto operand = detail::as_operand(view);
+  using operand_type = std::remove_const_t<decltype(operand)>;
+  using value_type   = typename detail::value_of<decltype(operand(std::array<std::size_t, operand_type::rank()> {}))>::type;
+  using vector_type  = vector<value_type, operand_type::rank()>;
+
+  typename vector_type::multi_size_type size;
+  for (std::size_t i = 0; i < size.size(); ++i)
+    size[i] = operand.extent(i);
+
+  vector_type result;
+  if constexpr (operand_type::rank() == 1)
+    result = vector_type(size[0], value_type());
+  else
+    result = vector_type(size   , value_type());
+  multi::copy(operand, result, policy);
+  return result;
+}
+}
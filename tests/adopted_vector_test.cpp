@@ -0,0 +1,92 @@
+#include "internal/doctest.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+
+#include <multi/adopted_vector.hpp>
+#include <multi/algorithm.hpp>
+#include <multi/view.hpp>
+
+TEST_CASE("multi::adopted_vector")
+{
+  using vector_type = multi::adopted_vector<float, 2>;
+
+  std::size_t deletions = 0;
+  const auto  allocate  = [] (std::size_t size) { return static_cast<float*>(std::malloc(size * sizeof(float))); };
+  const auto  deleter   = [&] (float* data) { ++deletions; std::free(data); };
+
+  // Constructor tests.
+  {
+    vector_type constructor1;
+    REQUIRE(constructor1.empty());
+    REQUIRE(constructor1.data() == nullptr);
+
+    auto* buffer = allocate(12);
+    {
+      vector_type constructor2(buffer, {3, 4}, deleter);
+      REQUIRE(constructor2.data() == buffer);
+      REQUIRE(constructor2.size() == 12);
+      REQUIRE(constructor2.dimensions() == vector_type::multi_size_type {3, 4});
+
+      vector_type constructor3(std::move(constructor2));
+      REQUIRE(constructor3.data() == buffer);
+      REQUIRE(constructor2.empty());
+      REQUIRE(constructor2.data() == nullptr);
+
+      constructor1 = std::move(constructor3);
+      REQUIRE(constructor1.data() == buffer);
+    }
+    REQUIRE(deletions == 0);
+    constructor1.reset();
+    REQUIRE(deletions == 1);
+    REQUIRE(constructor1.empty());
+
+    multi::adopted_vector<int, 1> constructor4(new int[5] {1, 2, 3, 4, 5}, 5, [] (int* data) { delete[] data; });
+    REQUIRE(constructor4.size() == 5);
+    REQUIRE(constructor4.back() == 5);
+  }
+
+  // Element access tests.
+  {
+    vector_type vector(allocate(12), {3, 4}, deleter);
+    std::iota(vector.begin(), vector.end(), 0.0f);
+    REQUIRE(vector(1, 2) == 6.0f);
+    REQUIRE(vector[{2, 3}] == 11.0f);
+    REQUIRE(vector[5] == 5.0f);
+    REQUIRE(vector.at(2, 0) == 8.0f);
+    REQUIRE(vector.front() == 0.0f);
+    REQUIRE(*vector.rbegin() == 11.0f);
+    REQUIRE_THROWS_AS(vector.at(3, 0), std::out_of_range);
+    REQUIRE_THROWS_AS(vector.at(12)  , std::out_of_range);
+
+    std::size_t count = 0;
+    for (const auto& [element, position] : std::as_const(vector).indexed())
+      count += element == static_cast<float>(position[0] * 4 + position[1]);
+    REQUIRE(count == 12);
+
+    // Views and algorithms.
+    multi::view<const float, 2> view = vector;
+    REQUIRE(view.data() == vector.data());
+    REQUIRE(multi::minmax(vector) == std::pair(0.0f, 11.0f));
+    multi::fill(vector, 1.0f);
+    REQUIRE(view(2, 3) == 1.0f);
+  }
+  REQUIRE(deletions == 2);
+
+  // Release tests.
+  {
+    auto* buffer = allocate(6);
+    vector_type vector(buffer, {2, 3}, deleter);
+    auto release = vector.get_deleter();
+    auto* data   = vector.release();
+    REQUIRE(data == buffer);
+    REQUIRE(vector.empty());
+    REQUIRE(vector.data() == nullptr);
+    REQUIRE(deletions == 2);
+    release(data);
+    REQUIRE(deletions == 3);
+  }
+  REQUIRE(deletions == 3);
+}
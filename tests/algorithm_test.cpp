@@ -0,0 +1,147 @@
+#include "internal/doctest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include <multi/algorithm.hpp>
+#include <multi/array.hpp>
+#include <multi/cow_vector.hpp>
+#include <multi/execution.hpp>
+#include <multi/vector.hpp>
+
+template <typename _target>
+concept fillable = requires (_target&& target) { multi::fill(target, 1.0f); multi::clamp(target, 0.0f, 1.0f); };
+template <typename _target>
+concept copyable = requires (_target&& target, const multi::vector<float, 2>& source) { multi::copy(source, target); multi::convert(source, target); };
+
+TEST_CASE("multi::algorithm")
+{
+  // Container tests.
+  {
+    multi::vector<float, 2> vector({3, 5}, 0.0f);
+    multi::fill(vector, 2.0f);
+    REQUIRE(vector == multi::vector<float, 2>({3, 5}, 2.0f));
+    vector(1, 2) = -4.0f;
+    vector(2, 4) =  9.0f;
+    REQUIRE(multi::minmax(vector) == std::pair(-4.0f, 9.0f));
+
+    multi::clamp(vector, 0.0f, 5.0f);
+    REQUIRE(vector(1, 2) == 0.0f);
+    REQUIRE(vector(2, 4) == 5.0f);
+
+    const auto converted = multi::convert<std::uint8_t>(vector);
+    REQUIRE(converted.dimensions() == vector.dimensions());
+    REQUIRE(converted(2, 4) == 5);
+    REQUIRE(converted(0, 0) == 2);
+
+    multi::vector<float, 2> copy({3, 5}, 0.0f);
+    multi::copy(vector, copy);
+    REQUIRE(multi::equal(vector, copy));
+    REQUIRE(copy == vector);
+    copy(0, 0) = 1.0f;
+    REQUIRE(!multi::equal(vector, copy));
+    REQUIRE(copy != vector);
+    REQUIRE(!multi::equal(vector, multi::vector<float, 2>({5, 3}, 0.0f)));
+    REQUIRE_THROWS_AS(multi::copy(vector, multi::vector<float, 2>({5, 3}, 0.0f)), std::invalid_argument);
+
+    // Const containers are not writable targets, while views of mutable elements are.
+    static_assert(!fillable<const multi::vector<float, 2>&>);
+    static_assert( fillable<      multi::vector<float, 2>&>);
+    static_assert( fillable<const multi::vector<float, 2>::span_type&>);
+    static_assert(!copyable<const multi::vector<float, 2>&>);
+    static_assert( copyable<      multi::vector<float, 2>&>);
+
+    multi::vector<int, 1> filled(10, 0);
+    filled.fill(7);
+    REQUIRE(filled == multi::vector<int, 1>(10, 7));
+
+    multi::array<std::int16_t, multi::dimensions<4, 4>> array(1);
+    array.fill(3);
+    REQUIRE(array == multi::array<std::int16_t, multi::dimensions<4, 4>>(3));
+    REQUIRE(multi::minmax(array) == std::pair<std::int16_t, std::int16_t>(3, 3));
+  }
+
+  // Strided span tests: runs fall back to rows, or to single elements.
+  {
+    using extents_type = std::experimental::dextents<2>;
+    using stride_span  = std::experimental::mdspan<int, extents_type, std::experimental::layout_stride>;
+    using left_span    = std::experimental::mdspan<int, extents_type, std::experimental::layout_left>;
+
+    multi::vector<int, 2> storage({6, 8}, 0);
+    // The 4x5 block at (1, 2) of the storage.
+    const stride_span block(storage.data() + 10, stride_span::mapping_type(extents_type(4, 5), std::array<std::size_t, 2> {8, 1}));
+    multi::fill(block, 1);
+    std::size_t count = 0;
+    for (const auto value : storage)
+      count += static_cast<std::size_t>(value);
+    REQUIRE(count == 20);
+    REQUIRE(storage(1, 2) == 1);
+    REQUIRE(storage(4, 6) == 1);
+    REQUIRE(storage(5, 6) == 0);
+
+    // Transposing copy: no common unit-stride axis.
+    multi::vector<int, 2> source({4, 5}, 0);
+    for (std::size_t i = 0; i < 4; ++i)
+      for (std::size_t j = 0; j < 5; ++j)
+        source(i, j) = static_cast<int>(i * 5 + j);
+    multi::vector<int, 2, std::experimental::layout_left> target({4, 5}, 0);
+    multi::copy(source, target);
+    REQUIRE(multi::equal(source, target));
+    REQUIRE(target.span()(3, 4) == 19);
+    REQUIRE(target.storage()[1] == 5);
+
+    const left_span left(target.data(), 4, 5);
+    REQUIRE(multi::minmax(left) == std::pair(0, 19));
+  }
+
+  // Layout conversion tests.
+  {
+    using std::experimental::layout_left;
+
+    // Extents which are not multiples of the block size, large enough to be copied in parallel.
+    multi::vector<double, 3> source({37, 70, 65}, 0.0);
+    for (std::size_t i = 0; i < source.size(); ++i)
+      source[i] = static_cast<double>(i);
+
+    for (const std::size_t thread_count : {1, 3})
+    {
+      const multi::execution::parallel_policy policy {thread_count};
+
+      multi::vector<double, 3, layout_left> left({37, 70, 65}, 0.0);
+      multi::copy(source, left, policy);
+      REQUIRE(left.span()(36, 69, 64) == source(36, 69, 64));
+      REQUIRE(left.span()(5, 40, 33) == source(5, 40, 33));
+      REQUIRE(multi::equal(source, left));
+
+      multi::vector<double, 3> right({37, 70, 65}, 0.0);
+      multi::copy(left, right, policy);
+      REQUIRE(right == source);
+
+      multi::vector<double, 3> same({37, 70, 65}, 0.0);
+      multi::copy(source, same, policy);
+      REQUIRE(same == source);
+    }
+
+    // 1D and strided spans.
+    multi::vector<int, 1> line(100, 0), half(50, 0);
+    for (std::size_t i = 0; i < line.size(); ++i)
+      line[i] = static_cast<int>(i);
+    using stride_span = std::experimental::mdspan<int, std::experimental::dextents<1>, std::experimental::layout_stride>;
+    const stride_span even(line.data(), stride_span::mapping_type(std::experimental::dextents<1>(50), std::array<std::size_t, 1> {2}));
+    multi::copy(even, half);
+    REQUIRE(half[49] == 98);
+
+    // Layouts which are not strided.
+    multi::cow_vector<float, 2, 8> tiled({20, 13}, 0.0f);
+    for (std::size_t i = 0; i < 20; ++i)
+      for (std::size_t j = 0; j < 13; ++j)
+        tiled(i, j) = static_cast<float>(i * 13 + j);
+    multi::vector<float, 2, layout_left> untiled({20, 13}, 0.0f);
+    multi::copy(tiled.span(), untiled);
+    REQUIRE(untiled.span()(19, 12) == 259.0f);
+    REQUIRE(untiled.span()(7, 3) == 94.0f);
+
+    REQUIRE_THROWS_AS(multi::copy(source, multi::vector<double, 3>({37, 70, 64}, 0.0)), std::invalid_argument);
+  }
+}
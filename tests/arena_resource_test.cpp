@@ -0,0 +1,95 @@
+#include "internal/doctest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+#include <multi/arena_resource.hpp>
+#include <multi/vector.hpp>
+
+namespace
+{
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+  std::size_t allocations   = 0;
+  std::size_t deallocations = 0;
+
+protected:
+  void* do_allocate  (std::size_t bytes, std::size_t alignment) override
+  {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void  do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+  {
+    ++deallocations;
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+  }
+  bool  do_is_equal  (const std::pmr::memory_resource& that) const noexcept override
+  {
+    return this == &that;
+  }
+};
+}
+
+TEST_CASE("multi::pmr::arena_resource")
+{
+  // Allocation tests.
+  {
+    counting_resource          upstream;
+    multi::pmr::arena_resource arena(1024, &upstream);
+    REQUIRE(arena.capacity() == 0);
+
+    const auto pointer1 = arena.allocate(100, 4);
+    const auto pointer2 = arena.allocate(100, 256);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(pointer1) % multi::pmr::arena_resource::minimum_alignment == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(pointer2) % 256 == 0);
+    REQUIRE(arena.size       () == 200);
+    REQUIRE(upstream.allocations == 1);
+
+    // The most recent allocation is rolled back.
+    arena.deallocate(pointer2, 100, 256);
+    REQUIRE(arena.size() == 100);
+    REQUIRE(arena.allocate(100, 256) == pointer2);
+
+    // Larger requests take new chunks.
+    REQUIRE(arena.allocate(4096, 64) != nullptr);
+    REQUIRE(arena.chunk_count() == 2);
+    REQUIRE(upstream.allocations == 2);
+  }
+
+  // Reuse tests.
+  {
+    counting_resource          upstream;
+    multi::pmr::arena_resource arena(1024, &upstream);
+
+    const auto cycle = [&]
+    {
+      multi::pmr::vector<float, 2> vector1({64, 64}, 1.0f, &arena);
+      multi::pmr::vector<float, 2> vector2({32, 16}, 2.0f, &arena);
+      multi::pmr::vector<float, 1> vector3(512      , 3.0f, &arena);
+      REQUIRE(vector1.at(63, 63) == 1.0f);
+      REQUIRE(vector2.at(31, 15) == 2.0f);
+      REQUIRE(vector3.at(511)    == 3.0f);
+    };
+
+    cycle();
+    REQUIRE(arena.chunk_count() > 1);
+    arena.reset();
+    REQUIRE(arena.chunk_count() == 1);
+    REQUIRE(arena.size       () == 0);
+
+    const auto allocations = upstream.allocations;
+    for (auto i = 0; i < 8; ++i)
+    {
+      cycle();
+      arena.reset();
+    }
+    REQUIRE(upstream.allocations == allocations);
+
+    arena.release();
+    REQUIRE(arena.capacity() == 0);
+    REQUIRE(upstream.deallocations == upstream.allocations);
+  }
+}
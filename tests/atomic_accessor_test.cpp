@@ -0,0 +1,70 @@
+#include "internal/doctest.h"
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <multi/atomic_accessor.hpp>
+
+TEST_CASE("multi::atomic_accessor")
+{
+  // Concurrent accumulation tests.
+  {
+    using vector_type = multi::vector<float, 3, std::experimental::layout_right, multi::atomic_accessor<float>>;
+
+    vector_type vector({4, 4, 4}, 0.0f);
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < 4; ++t)
+      threads.emplace_back([&vector]
+      {
+        for (auto i = 0; i < 1000; ++i)
+          vector(i % 4, (i / 4) % 4, (i / 16) % 4) += 1.0f;
+      });
+    for (auto& thread : threads)
+      thread.join();
+
+    float sum = 0.0f;
+    for (const auto value : vector)
+      sum += value;
+    REQUIRE(sum == 4000.0f);
+
+    vector(1, 2, 3) = 5.0f;
+    REQUIRE(static_cast<float>(vector(1, 2, 3)) == 5.0f);
+    REQUIRE(vector(1, 2, 3).fetch_add(1.0f) == 5.0f);
+    REQUIRE((vector(1, 2, 3) -= 2.0f) == 4.0f);
+    REQUIRE(vector(1, 2, 3).exchange(0.0f) == 4.0f);
+
+    const auto& constant = vector;
+    REQUIRE(constant(1, 2, 3) == 0.0f);
+  }
+  {
+    using vector_type = multi::vector<int, 2, std::experimental::layout_right, multi::atomic_accessor<int, std::memory_order_acq_rel>>;
+
+    vector_type vector({2, 2}, 0);
+    vector(0, 1) += 3;
+    vector(0, 1) = vector(0, 1);
+    REQUIRE(vector.at(0, 1) == 3);
+    REQUIRE(vector.storage()[1] == 3);
+  }
+
+  // Scatter tests.
+  for (const auto parallel : {false, true})
+  {
+    multi::vector<int, 2> histogram({21, 13}, 0);
+    const auto function = [ ] (const std::size_t i, auto&& add)
+    {
+      add({i % 21, i % 13}, 1);
+      add({20, 12}, 2);
+    };
+    if (parallel)
+      multi::scatter_add<4>(histogram, 10000, function, multi::execution::parallel_policy {4});
+    else
+      multi::scatter_add<4>(histogram, 10000, function);
+
+    multi::vector<int, 2> expected({21, 13}, 0);
+    for (std::size_t i = 0; i < 10000; ++i)
+      ++expected(i % 21, i % 13);
+    expected(20, 12) += 20000;
+    REQUIRE(histogram == expected);
+  }
+}
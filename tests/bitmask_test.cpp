@@ -0,0 +1,153 @@
+#include "internal/doctest.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <multi/bitmask.hpp>
+
+TEST_CASE("multi::bitmask")
+{
+  // 1D.
+  {
+    using bitmask_type = multi::bitmask<1>;
+
+    bitmask_type bitmask({130});
+    REQUIRE(bitmask.size     () == 130);
+    REQUIRE(bitmask.row_words() == 3);
+    REQUIRE(bitmask.none     ());
+
+    bitmask(0)   = true;
+    bitmask(64)  = true;
+    bitmask(129) = true;
+    REQUIRE(bitmask.count() == 3);
+    REQUIRE(bitmask(64));
+    REQUIRE(!bitmask(63));
+
+    bitmask.flip();
+    REQUIRE(bitmask.count() == 127);
+    bitmask.set();
+    REQUIRE(bitmask.all());
+    bitmask.reset();
+    REQUIRE(bitmask.none());
+
+    bitmask(63) = true;
+    bitmask.dilate();
+    REQUIRE(bitmask.count() == 3);
+    REQUIRE(bitmask(62));
+    REQUIRE(bitmask(64));
+    bitmask.erode();
+    REQUIRE(bitmask.count() == 1);
+    REQUIRE(bitmask(63));
+  }
+
+  // 3D.
+  {
+    using bitmask_type = multi::bitmask<3>;
+
+    // Constructor tests.
+    {
+      bitmask_type constructor1;
+      REQUIRE(constructor1.empty());
+
+      bitmask_type constructor2({4, 5, 70});
+      REQUIRE(constructor2.size() == 4 * 5 * 70);
+      REQUIRE(constructor2.storage().size() == 4 * 5 * 2);
+      REQUIRE(constructor2.none());
+
+      bitmask_type constructor3({4, 5, 70}, true);
+      REQUIRE(constructor3.all());
+      REQUIRE(constructor3.count() == 4 * 5 * 70);
+
+      bitmask_type constructor4(constructor3);
+      REQUIRE(constructor4 == constructor3);
+
+      bitmask_type constructor5(std::move(constructor4));
+      REQUIRE(constructor5 == constructor3);
+      REQUIRE(constructor4.empty());
+    }
+
+    // Element access tests.
+    {
+      bitmask_type bitmask({4, 5, 70});
+      bitmask(1, 2, 3)    = true;
+      bitmask[{3, 4, 69}] = true;
+      bitmask.at(0, 0, 64) = true;
+      bitmask(1, 2, 3).flip();
+
+      const auto& const_bitmask = bitmask;
+      REQUIRE(!const_bitmask(1, 2, 3));
+      REQUIRE( const_bitmask(3, 4, 69));
+      REQUIRE( const_bitmask.at(0, 0, 64));
+      REQUIRE(bitmask.count() == 2);
+      REQUIRE_THROWS_AS(bitmask.at(0, 0, 70), std::out_of_range);
+    }
+
+    // Bulk operation tests.
+    {
+      bitmask_type bitmask1({4, 5, 70});
+      bitmask_type bitmask2({4, 5, 70});
+      bitmask1(0, 0, 0) = bitmask1(1, 1, 1) = true;
+      bitmask2(1, 1, 1) = bitmask2(2, 2, 2) = true;
+
+      REQUIRE((bitmask1 & bitmask2).count() == 1);
+      REQUIRE((bitmask1 | bitmask2).count() == 3);
+      REQUIRE((bitmask1 ^ bitmask2).count() == 2);
+      REQUIRE((~bitmask1).count() == 4 * 5 * 70 - 2);
+    }
+
+    // Iteration tests.
+    {
+      bitmask_type bitmask({4, 5, 70});
+      REQUIRE(!bitmask.find_first());
+
+      bitmask(0, 3, 65) = true;
+      bitmask(2, 0, 1 ) = true;
+      bitmask(3, 4, 69) = true;
+      REQUIRE(bitmask.find_first() == bitmask_type::multi_size_type {0, 3, 65});
+
+      std::vector<bitmask_type::multi_size_type> positions;
+      bitmask.for_each_set([&] (const auto& position) { positions.push_back(position); });
+      REQUIRE(positions.size() == 3);
+      REQUIRE(positions[0] == bitmask_type::multi_size_type {0, 3, 65});
+      REQUIRE(positions[1] == bitmask_type::multi_size_type {2, 0, 1 });
+      REQUIRE(positions[2] == bitmask_type::multi_size_type {3, 4, 69});
+    }
+
+    // Morphology tests.
+    {
+      bitmask_type bitmask({4, 5, 70});
+      bitmask(2, 2, 64) = true;
+
+      bitmask.dilate(1, multi::execution::par);
+      REQUIRE(bitmask.count() == 7);
+      REQUIRE(bitmask(1, 2, 64));
+      REQUIRE(bitmask(3, 2, 64));
+      REQUIRE(bitmask(2, 1, 64));
+      REQUIRE(bitmask(2, 3, 64));
+      REQUIRE(bitmask(2, 2, 63));
+      REQUIRE(bitmask(2, 2, 65));
+
+      bitmask.erode(1, multi::execution::par);
+      REQUIRE(bitmask.count() == 1);
+      REQUIRE(bitmask(2, 2, 64));
+
+      bitmask.set().erode();
+      REQUIRE(bitmask.count() == 2 * 3 * 68);
+      bitmask.dilate(2);
+      REQUIRE(bitmask.all() == false);
+      REQUIRE(bitmask(0, 1, 1));
+      REQUIRE(!bitmask(0, 0, 0));
+    }
+
+    // Operations tests.
+    {
+      bitmask_type bitmask1({2, 2, 2}, true);
+      bitmask_type bitmask2({3, 3, 3});
+      multi::swap(bitmask1, bitmask2);
+      REQUIRE(bitmask1.none());
+      REQUIRE(bitmask2.all ());
+      REQUIRE(bitmask2.span().extent(0) == 2);
+    }
+  }
+}
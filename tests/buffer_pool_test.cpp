@@ -0,0 +1,91 @@
+#include "internal/doctest.h"
+
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <multi/buffer_pool.hpp>
+
+TEST_CASE("multi::buffer_pool")
+{
+  using pool_type = multi::buffer_pool<float, 2>;
+
+  // Size class tests.
+  {
+    REQUIRE(pool_type::size_class(0) == 0);
+    REQUIRE(pool_type::size_class(1) == 0);
+    REQUIRE(pool_type::size_class(2) == 1);
+    REQUIRE(pool_type::size_class(3) == 2);
+    REQUIRE(pool_type::size_class(4) == 2);
+    REQUIRE(pool_type::size_class(5) == 3);
+  }
+
+  // Acquire and recycle tests.
+  {
+    pool_type pool;
+    REQUIRE(pool.cached_count() == 0);
+
+    const float* data;
+    {
+      auto handle = pool.acquire({12, 10}, 1.0f);
+      REQUIRE(handle);
+      REQUIRE(handle->dimensions() == pool_type::multi_size_type {12, 10});
+      REQUIRE(handle->capacity  () == 128);
+      REQUIRE(handle->at(11, 9)    == 1.0f);
+      (*handle)(3, 4) = 2.0f;
+      data = handle->data();
+    }
+    REQUIRE(pool.cached_count() == 1);
+
+    // Shapes of the same size class reuse the storage.
+    {
+      auto handle = pool.acquire({8, 16}, 3.0f);
+      REQUIRE(handle->data() == data);
+      REQUIRE(handle->dimensions() == pool_type::multi_size_type {8, 16});
+      REQUIRE(handle->at(7, 15) == 3.0f);
+      REQUIRE(pool.cached_count() == 0);
+
+      auto other = pool.acquire({8, 8});
+      REQUIRE(other->data() != data);
+      REQUIRE(other->size() == 64);
+
+      auto moved = std::move(handle);
+      REQUIRE(!handle);
+      REQUIRE(moved->data() == data);
+    }
+    REQUIRE(pool.cached_count() == 2);
+
+    {
+      auto handle   = pool.acquire({10, 10});
+      auto released = handle.release();
+      REQUIRE(released.data() == data);
+      REQUIRE(!handle);
+    }
+    REQUIRE(pool.cached_count() == 1);
+
+    pool.clear();
+    REQUIRE(pool.cached_count() == 0);
+  }
+
+  // Concurrency tests.
+  {
+    pool_type pool(pool_type::allocator_type(), 4);
+
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < 8; ++i)
+      threads.emplace_back([&pool, i]
+      {
+        for (auto j = 0; j < 1000; ++j)
+        {
+          auto handle = pool.acquire({std::size_t(4 + (j % 3)), std::size_t(8)}, static_cast<float>(i));
+          REQUIRE(handle->at(3, 7) == static_cast<float>(i));
+        }
+      });
+    for (auto& thread : threads)
+      thread.join();
+
+    REQUIRE(pool.cached_count() >= 1);
+    REQUIRE(pool.cached_count() <= 8 * 2);
+  }
+}
@@ -0,0 +1,96 @@
+#include "internal/doctest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <multi/compressed_vector.hpp>
+
+TEST_CASE("multi::compressed_vector")
+{
+  // 1D.
+  {
+    multi::vector<std::uint8_t, 1> source {1, 1, 1, 2, 2, 3, 3, 3, 3, 1};
+
+    multi::compressed_vector<std::uint8_t, 1> vector(source);
+    REQUIRE(vector.size() == 10);
+    REQUIRE(vector.run_count() == 4);
+    for (std::size_t i = 0; i < 10; ++i)
+      REQUIRE(vector(i) == source(i));
+
+    REQUIRE(vector.decompress() == source);
+  }
+
+  // 3D.
+  {
+    using source_type = multi::vector<std::uint16_t, 3>;
+    using vector_type = multi::compressed_vector<std::uint16_t, 3>;
+
+    source_type source({8, 16, 32}, 0);
+    for (std::size_t x = 0; x < 4; ++x)
+      for (std::size_t y = 0; y < 16; ++y)
+        for (std::size_t z = 0; z < 32; ++z)
+          source(x, y, z) = static_cast<std::uint16_t>(z < 10 ? x : (z < 20 ? 100 + y : 7));
+    for (std::size_t y = 0; y < 16; ++y)
+      for (std::size_t z = 0; z < 32; ++z)
+        source(6, y, z) = 42;
+
+    // Constructor tests.
+    {
+      vector_type constructor1;
+      REQUIRE(constructor1.empty());
+
+      vector_type constructor2(source);
+      REQUIRE(constructor2.dimensions() == source.dimensions());
+      REQUIRE(constructor2.run_count () == 4 * 16 * 3);
+
+      vector_type constructor3(source, multi::execution::parallel_policy {3});
+      REQUIRE(constructor3.run_count () == constructor2.run_count());
+      REQUIRE(constructor3.decompress() == constructor2.decompress());
+
+      vector_type constructor4(constructor3);
+      REQUIRE(constructor4.run_count () == constructor3.run_count());
+
+      REQUIRE(constructor4.memory_size() < source.size() * sizeof(std::uint16_t));
+    }
+
+    // Element access tests.
+    {
+      vector_type vector(source, multi::execution::par);
+      for (std::size_t x = 0; x < 8; ++x)
+        for (std::size_t y = 0; y < 16; ++y)
+          for (std::size_t z = 0; z < 32; ++z)
+          {
+            REQUIRE(vector   ( x, y, z ) == source(x, y, z));
+            REQUIRE(vector   [{x, y, z}] == source(x, y, z));
+            REQUIRE(vector.at( x, y, z ) == source(x, y, z));
+          }
+      REQUIRE_THROWS_AS(vector.at(8, 0, 0), std::out_of_range);
+    }
+
+    // Decode tests.
+    {
+      vector_type vector(source);
+
+      std::vector<std::uint16_t> row(vector.row_size());
+      for (std::size_t r = 0; r < vector.row_count(); ++r)
+      {
+        vector.decode_row(r, row.begin());
+        for (std::size_t z = 0; z < row.size(); ++z)
+          REQUIRE(row[z] == source.data()[r * row.size() + z]);
+      }
+
+      REQUIRE(vector.decompress(multi::execution::par) == source);
+    }
+
+    // Operations tests.
+    {
+      vector_type vector1(source);
+      vector_type vector2;
+      multi::swap(vector1, vector2);
+      REQUIRE(vector1.empty());
+      REQUIRE(vector2.decompress() == source);
+    }
+  }
+}
@@ -0,0 +1,90 @@
+#include "internal/doctest.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <multi/conversion_accessor.hpp>
+
+TEST_CASE("multi::conversion_accessor")
+{
+  // Float16 tests.
+  {
+    using vector_type = multi::vector<multi::float16, 3, std::experimental::layout_right, multi::float16_accessor>;
+
+    vector_type vector({2, 3, 4}, multi::float16());
+    REQUIRE(sizeof(vector.storage()[0]) == 2);
+
+    vector(1, 2, 3) = 1.5f;
+    vector(0, 0, 0) = 2.0f;
+    vector(0, 0, 0) += 0.25f;
+    vector(0, 0, 0) *= 2.0f;
+    vector({1, 1, 1}) = vector(1, 2, 3);
+
+    const auto& const_vector = vector;
+    const float value = const_vector(1, 2, 3);
+    REQUIRE(value == 1.5f);
+    REQUIRE(static_cast<float>(vector(0, 0, 0)) == 4.5f);
+    REQUIRE(static_cast<float>(vector.at(1, 1, 1)) == 1.5f);
+
+    vector.resize({4, 4, 4});
+    REQUIRE(vector.size() == 64);
+  }
+
+  // Bfloat16 tests.
+  {
+    multi::vector<multi::bfloat16, 2, std::experimental::layout_right, multi::bfloat16_accessor> vector({2, 2}, multi::bfloat16());
+    vector(1, 1) = 3.0f;
+    REQUIRE(static_cast<float>(vector(1, 1)) == 3.0f);
+  }
+
+  // Quantized tests.
+  {
+    using vector_type = multi::vector<std::uint8_t, 2, std::experimental::layout_right, multi::quantized_accessor<std::uint8_t>>;
+
+    vector_type vector({4, 4}, 0);
+    vector.set_accessor(multi::quantized_accessor<std::uint8_t>({0.5f, -10.0f}));
+
+    vector(0, 0) = -10.0f;
+    vector(0, 1) = 0.0f;
+    vector(0, 2) = 1000.0f;
+    vector(0, 3) = -1000.0f;
+    vector(1, 0) = 0.3f;
+    REQUIRE(vector.storage()[0] == 0);
+    REQUIRE(vector.storage()[1] == 20);
+    REQUIRE(vector.storage()[2] == 255);
+    REQUIRE(vector.storage()[3] == 0);
+    REQUIRE(static_cast<float>(vector(0, 1)) == 0.0f);
+    REQUIRE(static_cast<float>(vector(1, 0)) == 0.5f);
+
+    // The accessor survives resizing.
+    vector.resize({8, 8});
+    vector(7, 7) = 0.0f;
+    REQUIRE(vector.get_accessor().codec().scale == 0.5f);
+    REQUIRE(static_cast<float>(vector(7, 7)) == 0.0f);
+  }
+
+  // Container conversion tests.
+  {
+    multi::vector<float, 3> source({8, 64, 64}, 0.0f);
+    for (std::size_t i = 0; i < source.size(); ++i)
+      source[i] = std::sin(static_cast<float>(i));
+
+    multi::vector<multi::float16, 3, std::experimental::layout_right, multi::float16_accessor> half;
+    multi::encode(source, half, multi::execution::par);
+    REQUIRE(half.dimensions() == source.dimensions());
+
+    multi::vector<float, 3> result;
+    multi::decode(half, result, multi::execution::par);
+    REQUIRE(result.dimensions() == source.dimensions());
+    for (std::size_t i = 0; i < source.size(); ++i)
+      REQUIRE(std::abs(result[i] - source[i]) <= 1.0f / 1024.0f);
+
+    multi::vector<std::uint16_t, 3, std::experimental::layout_right, multi::quantized_accessor<std::uint16_t>> quantized;
+    quantized.set_accessor(multi::quantized_accessor<std::uint16_t>({2.0f / 65535.0f, -1.0f}));
+    multi::encode(source   , quantized);
+    multi::decode(quantized, result   );
+    for (std::size_t i = 0; i < source.size(); ++i)
+      REQUIRE(std::abs(result[i] - source[i]) <= 1.0f / 65535.0f + 1e-6f);
+  }
+}
@@ -0,0 +1,181 @@
+#include "internal/doctest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <multi/cow_vector.hpp>
+#include <multi/vector.hpp>
+
+TEST_CASE("multi::cow_vector")
+{
+  using vector_type = multi::cow_vector<float, 3, 4>;
+
+  // Constructor tests.
+  {
+    vector_type constructor1;
+    REQUIRE(constructor1.empty());
+    REQUIRE(constructor1.tile_count() == 0);
+
+    vector_type constructor2({10, 8, 5}, 1.0f);
+    REQUIRE(constructor2.size() == 10 * 8 * 5);
+    REQUIRE(constructor2.tile_count() == 3 * 2 * 2);
+    REQUIRE(constructor2.tile_volume() == 64);
+    REQUIRE(constructor2.tiles()[0] == constructor2.tiles()[11]);
+    REQUIRE(std::as_const(constructor2)(9, 7, 4) == 1.0f);
+
+    multi::vector<float, 3> source({10, 8, 5}, 0.0f);
+    for (std::size_t i = 0; i < source.size(); ++i)
+      source[i] = static_cast<float>(i);
+    const vector_type constructor3(source);
+    REQUIRE(constructor3.dimensions() == source.dimensions());
+    REQUIRE(constructor3(0, 0, 0) == 0.0f);
+    REQUIRE(constructor3(9, 7, 4) == source(9, 7, 4));
+    REQUIRE(constructor3(3, 5, 1) == source(3, 5, 1));
+    REQUIRE(constructor3.tiles()[0] != constructor3.tiles()[1]);
+
+    vector_type constructor4(constructor3);
+    REQUIRE(constructor4.tiles() == constructor3.tiles());
+    REQUIRE(constructor4 == constructor3);
+
+    vector_type constructor5(std::move(constructor4));
+    REQUIRE(constructor5 == constructor3);
+    REQUIRE(constructor4.empty());
+    REQUIRE(constructor4.tile_count() == 0);
+
+    multi::mixed_vector<float, std::experimental::extents<std::experimental::dynamic_extent, 8, 5>> mixed({10}, 2.0f);
+    mixed(9, 7, 4) = 3.0f;
+    const vector_type constructor6(mixed);
+    REQUIRE(constructor6.dimensions() == mixed.dimensions());
+    REQUIRE(constructor6(0, 0, 0) == 2.0f);
+    REQUIRE(constructor6(9, 7, 4) == 3.0f);
+  }
+
+  // Copy-on-write tests.
+  {
+    vector_type vector({10, 8, 5}, -1.0f);
+    const auto snapshot = vector;
+    REQUIRE(vector.shared({0, 0, 0}));
+
+    vector(5, 6, 2) = 3.0f;
+    REQUIRE(vector(5, 6, 2) == 3.0f);
+    REQUIRE(snapshot(5, 6, 2) == -1.0f);
+    REQUIRE(!vector.shared({1, 1, 0}));
+    REQUIRE(vector.shared({0, 0, 0}));
+    REQUIRE(vector != snapshot);
+
+    // Only the modified tile differs.
+    std::size_t different = 0;
+    for (std::size_t i = 0; i < vector.tile_count(); ++i)
+      different += vector.tiles()[i] != snapshot.tiles()[i];
+    REQUIRE(different == 1);
+
+    // Writing the unshared tile does not copy it again.
+    const auto* tile = vector.tiles()[4].get();
+    vector(4, 7, 3) = 4.0f;
+    REQUIRE(vector.tiles()[4].get() == tile);
+
+    auto& block = vector.tile({2, 0, 1});
+    block.fill(2.0f);
+    REQUIRE(vector(9, 0, 4) == 2.0f);
+    REQUIRE(snapshot(9, 0, 4) == -1.0f);
+
+    vector.fill(-1.0f);
+    REQUIRE(vector == snapshot);
+    REQUIRE(vector.tiles()[0] == vector.tiles()[5]);
+  }
+
+  // Element access tests.
+  {
+    vector_type vector({10, 8, 5}, 0.0f);
+    vector.at(9, 7, 4) = 1.0f;
+    REQUIRE(vector[{9, 7, 4}] == 1.0f);
+    REQUIRE(std::as_const(vector).at(9, 7, 4) == 1.0f);
+    REQUIRE_THROWS_AS(vector.at(10, 0, 0), std::out_of_range);
+    REQUIRE_THROWS_AS(std::as_const(vector).at(0, 8, 0), std::out_of_range);
+
+    // Linear indices follow the layout_right order of the positions.
+    REQUIRE(vector[vector.size() - 1] == 1.0f);
+    REQUIRE(&std::as_const(vector).at(std::size_t(1 * 8 * 5 + 2 * 5 + 3)) == &std::as_const(vector)(1, 2, 3));
+    REQUIRE_THROWS_AS(vector.at(vector.size()), std::out_of_range);
+    REQUIRE_THROWS_AS(std::as_const(vector).at(vector.size()), std::out_of_range);
+
+    const auto snapshot = vector;
+    vector.front() = 2.0f;
+    vector.back () = 3.0f;
+    REQUIRE(vector(0, 0, 0) == 2.0f);
+    REQUIRE(std::as_const(vector).back() == 3.0f);
+    REQUIRE(snapshot.front() == 0.0f);
+    REQUIRE(snapshot.back () == 1.0f);
+  }
+
+  // Iterator tests.
+  {
+    vector_type vector({10, 8, 5}, 0.0f);
+    for (std::size_t i = 0; i < vector.size(); ++i)
+      vector[i] = static_cast<float>(i);
+
+    const auto& view = vector;
+    REQUIRE(std::distance(view.begin(), view.end()) == 400);
+    REQUIRE(std::equal(view.cbegin(), view.cend(), multi::coords(view.dimensions()).begin(), [&] (const float& value, const auto& position)
+    {
+      return &value == &view(position);
+    }));
+    REQUIRE(std::accumulate(view.begin(), view.end(), 0.0f) == 399.0f * 400.0f / 2.0f);
+    REQUIRE(*(view.begin() + 57) == 57.0f);
+    REQUIRE(*view.rbegin() == 399.0f);
+    REQUIRE(std::is_sorted(view.begin(), view.end()));
+    REQUIRE(vector_type().begin() == vector_type().end());
+
+    std::size_t count = 0;
+    for (const auto& [value, position] : view.indexed())
+    {
+      REQUIRE(&value == &view(position));
+      REQUIRE(value == static_cast<float>(count++));
+    }
+    REQUIRE(count == view.size());
+    REQUIRE(view.indexed().size() == view.size());
+  }
+
+  // Span tests.
+  {
+    vector_type vector({10, 8, 5}, 0.0f);
+    for (std::size_t i = 0; i < 10; ++i)
+      for (std::size_t j = 0; j < 8; ++j)
+        for (std::size_t k = 0; k < 5; ++k)
+          vector(i, j, k) = static_cast<float>(i * 100 + j * 10 + k);
+
+    const auto& span = vector.span();
+    REQUIRE(span.extent(0) == 10);
+    REQUIRE(span.extent(2) == 5);
+    REQUIRE(span(7, 3, 4) == 734.0f);
+    REQUIRE(span(9, 7, 0) == 970.0f);
+    REQUIRE(span.mapping().required_span_size() == vector.tile_count() * vector.tile_volume());
+
+    const auto snapshot = vector;
+    vector(7, 3, 4) = 0.0f;
+    REQUIRE(snapshot.span()(7, 3, 4) == 734.0f);
+    REQUIRE(vector  .span()(7, 3, 4) == 0.0f);
+  }
+
+  // Concurrent reader tests.
+  {
+    vector_type vector({32, 32, 32}, 0.0f);
+    const auto  snapshot = vector;
+    std::thread reader([&]
+    {
+      for (std::size_t i = 0; i < 32; ++i)
+        for (std::size_t j = 0; j < 32; ++j)
+          for (std::size_t k = 0; k < 32; ++k)
+            REQUIRE(snapshot(i, j, k) == 0.0f);
+    });
+    for (std::size_t i = 0; i < 32; ++i)
+      vector(i, i, i) = 1.0f;
+    reader.join();
+    REQUIRE(vector(31, 31, 31) == 1.0f);
+  }
+}
@@ -0,0 +1,179 @@
+#include "internal/doctest.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <multi/decomposed_vector.hpp>
+
+namespace
+{
+// Moves messages as bytes through a mailbox shared by several decomposed_vectors, each owning a subset of the blocks,
+// as a shared-memory multi-process transport would.
+struct byte_mailbox
+{
+  std::mutex                                                                           mutex    ;
+  std::condition_variable                                                              condition;
+  std::map<std::tuple<std::size_t, std::size_t, std::size_t>, std::vector<std::byte>> messages ;
+};
+
+class byte_transport
+{
+public:
+  using buffer_type = std::vector<float>;
+
+  byte_transport(byte_mailbox& mailbox, std::size_t rank, std::size_t rank_count)
+  : mailbox_(mailbox), rank_(rank), rank_count_(rank_count)
+  {
+
+  }
+
+  bool        local  (std::size_t block) const noexcept
+  {
+    return block % rank_count_ == rank_;
+  }
+  void        send   (std::size_t source, std::size_t target, std::size_t tag, buffer_type&& buffer)
+  {
+    std::vector<std::byte> bytes(buffer.size() * sizeof(float));
+    if (!bytes.empty())
+      std::memcpy(bytes.data(), buffer.data(), bytes.size());
+    {
+      std::lock_guard lock(mailbox_.mutex);
+      mailbox_.messages.emplace(std::make_tuple(target, source, tag), std::move(bytes));
+    }
+    mailbox_.condition.notify_all();
+  }
+  buffer_type receive(std::size_t target, std::size_t source, std::size_t tag)
+  {
+    std::unique_lock lock(mailbox_.mutex);
+    const auto key = std::make_tuple(target, source, tag);
+    mailbox_.condition.wait(lock, [&] { return mailbox_.messages.contains(key); });
+    const auto& bytes = mailbox_.messages.at(key);
+    buffer_type result(bytes.size() / sizeof(float));
+    if (!bytes.empty())
+      std::memcpy(result.data(), bytes.data(), bytes.size());
+    mailbox_.messages.erase(key);
+    return result;
+  }
+
+protected:
+  byte_mailbox& mailbox_   ;
+  std::size_t   rank_      ;
+  std::size_t   rank_count_;
+};
+
+// Checks that every halo element of every local block holds the global value at its position, or its initial value
+// outside the global domain.
+template <typename _vector>
+void check_halos(_vector& vector, float initial)
+{
+  const auto dimensions = vector.dimensions();
+  for (std::size_t index = 0; index < vector.block_count(); ++index)
+  {
+    if (!vector.local(index))
+      continue;
+
+    auto& block = vector.block(index);
+    for (std::size_t i = 0; i < block.data.dimensions()[0]; ++i)
+      for (std::size_t j = 0; j < block.data.dimensions()[1]; ++j)
+      {
+        const auto x = static_cast<std::ptrdiff_t>(block.origin[0] + i) - static_cast<std::ptrdiff_t>(block.halo);
+        const auto y = static_cast<std::ptrdiff_t>(block.origin[1] + j) - static_cast<std::ptrdiff_t>(block.halo);
+        const auto inside = x >= 0 && y >= 0 && x < static_cast<std::ptrdiff_t>(dimensions[0]) && y < static_cast<std::ptrdiff_t>(dimensions[1]);
+        REQUIRE(block.data(i, j) == (inside ? static_cast<float>(x * 100 + y) : initial));
+      }
+  }
+}
+}
+
+TEST_CASE("multi::decomposed_vector")
+{
+  // Decomposition tests.
+  {
+    multi::decomposed_vector<float, 2> vector({10, 9}, {3, 2}, 2, -1.0f);
+    REQUIRE(vector.block_count() == 6);
+    REQUIRE(vector.block(0).extent == std::array<std::size_t, 2> {4, 5});
+    REQUIRE(vector.block(5).origin == std::array<std::size_t, 2> {7, 5});
+    REQUIRE(vector.block(5).data.dimensions() == std::array<std::size_t, 2> {7, 8});
+    REQUIRE(vector.block_coordinates(3) == std::array<std::size_t, 2> {1, 1});
+    REQUIRE(vector.block_index({2, 1}) == 5);
+
+    for (std::size_t i = 0; i < 10; ++i)
+      for (std::size_t j = 0; j < 9; ++j)
+        vector.at(i, j) = static_cast<float>(i * 100 + j);
+    REQUIRE(vector.at(7, 5) == vector.block(5)({0, 0}));
+    REQUIRE_THROWS_AS(vector.at(10, 0), std::out_of_range);
+
+    const auto global = vector.gather();
+    REQUIRE(global.at(9, 8) == 908.0f);
+
+    REQUIRE_THROWS_AS((multi::decomposed_vector<float, 2>({4, 4}, {4, 1}, 2)), std::invalid_argument);
+  }
+
+  // Exchange tests.
+  for (const auto parallel : {false, true})
+  {
+    multi::decomposed_vector<float, 2> vector({10, 9}, {3, 2}, 2, -1.0f);
+    for (std::size_t i = 0; i < 10; ++i)
+      for (std::size_t j = 0; j < 9; ++j)
+        vector.at(i, j) = static_cast<float>(i * 100 + j);
+
+    if (parallel)
+    {
+      // Interior work overlaps the exchange.
+      vector.begin_exchange(multi::execution::par);
+      vector.for_each_block([ ] (auto& block) { block.data.at(std::size_t(0)) = block.data.at(std::size_t(0)); }, multi::execution::par);
+      vector.end_exchange  (multi::execution::par);
+    }
+    else
+      vector.exchange_halos();
+    check_halos(vector, -1.0f);
+  }
+  {
+    multi::decomposed_vector<float, 3> vector({6, 6, 6}, {2, 2, 2}, 1, 0.0f);
+    for (std::size_t i = 0; i < 6; ++i)
+      for (std::size_t j = 0; j < 6; ++j)
+        for (std::size_t k = 0; k < 6; ++k)
+          vector.at(i, j, k) = static_cast<float>(i * 36 + j * 6 + k);
+    vector.exchange_halos();
+
+    // The corner of block 0 receives from block 7.
+    REQUIRE(vector.block(0).data(4, 4, 4) == vector.at(3, 3, 3));
+    REQUIRE(vector.block(7).data(0, 0, 0) == vector.at(2, 2, 2));
+    REQUIRE(vector.block(0).data(4, 1, 2) == vector.at(3, 0, 1));
+  }
+
+  // Transport tests.
+  {
+    byte_mailbox   mailbox;
+    byte_transport transport0(mailbox, 0, 2);
+    byte_transport transport1(mailbox, 1, 2);
+
+    using vector_type = multi::decomposed_vector<float, 2, byte_transport>;
+    vector_type vector0({10, 9}, {3, 2}, 1, -1.0f, &transport0);
+    vector_type vector1({10, 9}, {3, 2}, 1, -1.0f, &transport1);
+    REQUIRE( vector0.local(0));
+    REQUIRE(!vector0.local(1));
+    REQUIRE( vector1.local(1));
+
+    for (auto* vector : {&vector0, &vector1})
+      for (std::size_t i = 0; i < 10; ++i)
+        for (std::size_t j = 0; j < 9; ++j)
+          if (vector->local(vector->block_index({std::size_t(i < 4 ? 0 : i < 7 ? 1 : 2), j < 5 ? std::size_t(0) : std::size_t(1)})))
+            vector->at(i, j) = static_cast<float>(i * 100 + j);
+    REQUIRE_THROWS_AS(vector0.at(0, 5), std::out_of_range);
+
+    std::thread thread([&] { vector1.exchange_halos(); });
+    vector0.exchange_halos();
+    thread.join();
+
+    check_halos(vector0, -1.0f);
+    check_halos(vector1, -1.0f);
+    REQUIRE(mailbox.messages.empty());
+  }
+}
@@ -0,0 +1,42 @@
+#include "internal/doctest.h"
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <multi/execution.hpp>
+
+TEST_CASE("multi::execution")
+{
+  // Partition tests.
+  {
+    REQUIRE(multi::partition_range(10, 3, 0) == std::pair<std::size_t, std::size_t>(0, 4 ));
+    REQUIRE(multi::partition_range(10, 3, 1) == std::pair<std::size_t, std::size_t>(4, 7 ));
+    REQUIRE(multi::partition_range(10, 3, 2) == std::pair<std::size_t, std::size_t>(7, 10));
+    REQUIRE(multi::partition_range(2 , 4, 3) == std::pair<std::size_t, std::size_t>(2, 2 ));
+
+    REQUIRE(multi::concurrency(multi::execution::seq) == 1);
+    REQUIRE(multi::concurrency(multi::execution::par) >= 1);
+    REQUIRE(multi::concurrency(multi::execution::parallel_policy {3}) == 3);
+  }
+
+  // For each index tests.
+  {
+    std::vector<int> values(1000, 0);
+    multi::for_each_index(multi::execution::seq, values.size(), [&] (const std::size_t i) { values[i] += 1; });
+    multi::for_each_index(multi::execution::parallel_policy {4}, values.size(), [&] (const std::size_t i) { values[i] += 1; });
+    for (const auto& value : values)
+      REQUIRE(value == 2);
+
+    std::atomic<std::size_t> count = 0;
+    multi::for_each_index(multi::execution::par, 0, [&] (const std::size_t) { ++count; });
+    REQUIRE(count == 0);
+
+    REQUIRE_THROWS_AS(multi::for_each_index(multi::execution::parallel_policy {4}, 8, [&] (const std::size_t i)
+    {
+      if (i == 5)
+        throw std::runtime_error("failure");
+    }), std::runtime_error);
+  }
+}
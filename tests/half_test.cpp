@@ -0,0 +1,71 @@
+#include "internal/doctest.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <multi/half.hpp>
+
+TEST_CASE("multi::half")
+{
+  // float16 tests.
+  {
+    REQUIRE(multi::float16(0.0f    ).bits == 0x0000);
+    REQUIRE(multi::float16(-0.0f   ).bits == 0x8000);
+    REQUIRE(multi::float16(1.0f    ).bits == 0x3C00);
+    REQUIRE(multi::float16(-2.0f   ).bits == 0xC000);
+    REQUIRE(multi::float16(65504.0f).bits == 0x7BFF);
+    REQUIRE(multi::float16(65520.0f).bits == 0x7C00);
+    REQUIRE(multi::float16(std::numeric_limits<float>::infinity()).bits == 0x7C00);
+    REQUIRE(multi::float16(std::ldexp(1.0f, -24)).bits == 0x0001);
+    REQUIRE(multi::float16(std::ldexp(1.0f, -25)).bits == 0x0000);
+    REQUIRE(multi::float16(std::ldexp(1.0f, -14)).bits == 0x0400);
+    REQUIRE(multi::float16(1.0f + std::ldexp(1.0f, -11)).bits == 0x3C00); // Tie, rounds to even.
+    REQUIRE(multi::float16(1.0f + std::ldexp(3.0f, -11)).bits == 0x3C02); // Tie, rounds to even.
+    REQUIRE(std::isnan(static_cast<float>(multi::float16(std::numeric_limits<float>::quiet_NaN()))));
+
+    for (std::uint32_t bits = 0; bits < 0x7C00; ++bits)
+    {
+      multi::float16 value;
+      value.bits = static_cast<std::uint16_t>(bits);
+      REQUIRE(multi::float16(static_cast<float>(value)).bits == bits);
+    }
+    REQUIRE(static_cast<float>(multi::float16(0.5f)) == 0.5f);
+    REQUIRE(multi::float16::to_float(0x0001) == std::ldexp(1.0f, -24));
+  }
+
+  // bfloat16 tests.
+  {
+    REQUIRE(multi::bfloat16(1.0f ).bits == 0x3F80);
+    REQUIRE(multi::bfloat16(-1.0f).bits == 0xBF80);
+    REQUIRE(static_cast<float>(multi::bfloat16(3.0f)) == 3.0f);
+    REQUIRE(multi::bfloat16(1.0f + std::ldexp(1.0f, -8)).bits == 0x3F80); // Tie, rounds to even.
+    REQUIRE(multi::bfloat16(1.0f + std::ldexp(3.0f, -8)).bits == 0x3F82); // Tie, rounds to even.
+    REQUIRE(std::isnan(static_cast<float>(multi::bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+  }
+
+  // Bulk conversion tests.
+  {
+    std::vector<float> source(37);
+    for (std::size_t i = 0; i < source.size(); ++i)
+      source[i] = static_cast<float>(i) * 0.3f - 5.0f;
+
+    std::vector<multi::float16> half(source.size());
+    std::vector<float>          result(source.size());
+    multi::convert(source.data(), source.data() + source.size(), half.data());
+    multi::convert(half.data(), half.data() + half.size(), result.data());
+    for (std::size_t i = 0; i < source.size(); ++i)
+    {
+      REQUIRE(half  [i].bits == multi::float16(source[i]).bits);
+      REQUIRE(result[i]      == static_cast<float>(half[i]));
+    }
+
+    std::vector<multi::bfloat16> brain(source.size());
+    multi::convert(source.data(), source.data() + source.size(), brain.data());
+    multi::convert(brain.data(), brain.data() + brain.size(), result.data());
+    for (std::size_t i = 0; i < source.size(); ++i)
+      REQUIRE(result[i] == static_cast<float>(brain[i]));
+  }
+}
@@ -0,0 +1,120 @@
+#include "internal/doctest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+
+#include <multi/algorithm.hpp>
+#include <multi/array.hpp>
+#include <multi/execution.hpp>
+#include <multi/hash.hpp>
+#include <multi/simd.hpp>
+#include <multi/vector.hpp>
+#include <multi/view.hpp>
+
+TEST_CASE("multi::hash")
+{
+  // Spans several chunks and ends with a partial stripe.
+  multi::vector<float, 2> volume({700, 1001}, 0.0f);
+  for (std::size_t i = 0; i < volume.size(); ++i)
+    volume.data()[i] = static_cast<float>(i % 977) * 0.5f;
+
+  // Determinism tests.
+  {
+    const auto hash = multi::content_hash(volume);
+    REQUIRE(multi::content_hash(volume, multi::execution::par) == hash);
+    REQUIRE(multi::content_hash(volume, multi::execution::parallel_policy {3}) == hash);
+
+    for (const auto limit : {multi::simd::instruction_set::scalar, multi::simd::instruction_set::sse4, multi::simd::instruction_set::avx2, multi::simd::instruction_set::avx512})
+    {
+      const auto previous = multi::simd::limit_instruction_set(limit);
+      REQUIRE(multi::content_hash(volume) == hash);
+      multi::simd::limit_instruction_set(previous);
+    }
+
+    REQUIRE(std::hash<multi::vector<float, 2>>()(volume) == static_cast<std::size_t>(hash));
+  }
+
+  // Content, shape and layout tests.
+  {
+    const auto hash = multi::content_hash(volume);
+
+    auto changed = volume;
+    changed(699, 1000) += 1.0f;
+    REQUIRE(multi::content_hash(changed) != hash);
+    changed = volume;
+    changed(350, 17) += 1.0f;
+    REQUIRE(multi::content_hash(changed) != hash);
+
+    multi::vector<float, 2> reshaped({1001, 700}, 0.0f);
+    std::copy_n(volume.data(), volume.size(), reshaped.data());
+    REQUIRE(multi::content_hash(reshaped) != hash);
+
+    multi::vector<float, 2, std::experimental::layout_left> transposed({700, 1001}, 0.0f);
+    std::copy_n(volume.data(), volume.size(), transposed.data());
+    REQUIRE(multi::content_hash(transposed) != hash);
+
+    // Equal elements hash equally.
+    multi::vector<double, 1> zeros(5, 0.0), negative_zeros(5, -0.0);
+    REQUIRE(zeros == negative_zeros);
+    REQUIRE(multi::content_hash(zeros) == multi::content_hash(negative_zeros));
+
+    multi::vector<int, 1> empty(0, 0);
+    REQUIRE(multi::content_hash(empty) != multi::content_hash(multi::vector<int, 1>(1, 0)));
+
+    using array_type = multi::array<std::uint8_t, multi::dimensions<3, 3>>;
+    std::unordered_set<array_type> set {array_type(1), array_type(2), array_type(1)};
+    REQUIRE(set.size() == 2);
+    REQUIRE(set.contains(array_type(2)));
+  }
+
+  // Strided view tests: only the viewed elements are hashed, in the order of their positions.
+  {
+    using stride_view  = multi::view<float, 2, std::experimental::layout_stride>;
+    using mapping_type = stride_view::mapping_type;
+
+    auto copy = volume;
+    const stride_view full(copy.data(), mapping_type(stride_view::extents_type(700, 1001), std::array<std::size_t, 2> {1001, 1}));
+    REQUIRE(multi::content_hash(full) == multi::content_hash(volume));
+
+    // Every other column, over several chunks.
+    const stride_view odd(copy.data() + 1, mapping_type(stride_view::extents_type(700, 500), std::array<std::size_t, 2> {1001, 2}));
+    const auto hash = multi::content_hash(odd);
+    REQUIRE(multi::content_hash(odd, multi::execution::par) == hash);
+    REQUIRE(multi::content_hash(odd, multi::execution::parallel_policy {3}) == hash);
+    REQUIRE(hash != multi::content_hash(full));
+
+    copy(699, 1000) = -1.0f;
+    copy(0  , 2   ) = -1.0f;
+    REQUIRE(multi::content_hash(odd) == hash);
+    copy(350, 1   ) = -1.0f;
+    REQUIRE(multi::content_hash(odd) != hash);
+  }
+
+  // Parallel equality tests.
+  {
+    auto copy = volume;
+    REQUIRE(multi::equal(volume, copy, multi::execution::par));
+    REQUIRE(multi::equal(volume, copy, multi::execution::parallel_policy {4}));
+    copy(400, 3) = -1.0f;
+    REQUIRE(!multi::equal(volume, copy, multi::execution::par));
+    REQUIRE(!multi::equal(volume, copy, multi::execution::parallel_policy {4}));
+    REQUIRE(!multi::equal(volume, multi::vector<float, 2>({701, 1001}, 0.0f), multi::execution::par));
+  }
+
+  // Ordering tests.
+  {
+    const multi::vector<int, 1> lhs {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    auto rhs = lhs;
+    REQUIRE((lhs <=> rhs) == std::strong_ordering::equal);
+    rhs(8) = 10;
+    REQUIRE(lhs < rhs);
+    rhs(2) = 0;
+    REQUIRE(lhs > rhs);
+    REQUIRE(lhs < multi::vector<int, 1> {1, 2, 3, 4, 5, 6, 7, 8, 9, 0});
+
+    using array_type = multi::array<float, multi::dimensions<2, 2>>;
+    REQUIRE(array_type {1.0f, 2.0f, 3.0f, 4.0f} < array_type {1.0f, 2.0f, 3.5f, 0.0f});
+    REQUIRE((array_type(1.0f) <=> array_type(1.0f)) == std::partial_ordering::equivalent);
+  }
+}
@@ -0,0 +1,47 @@
+#include "internal/doctest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <multi/huge_page_allocator.hpp>
+#include <multi/vector.hpp>
+
+TEST_CASE("multi::huge_page_allocator")
+{
+  using allocator_type = multi::huge_page_allocator<float>;
+
+  // Allocation tests.
+  for (const auto hugetlb : {false, true})
+  {
+    allocator_type allocator(hugetlb);
+    REQUIRE(allocator.hugetlb() == hugetlb);
+
+    const auto small = allocator.allocate(16);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(small) % alignof(float) == 0);
+    small[15] = 1.0f;
+    allocator.deallocate(small, 16);
+
+    const auto size  = allocator_type::huge_page_size / sizeof(float) * 3 / 2;
+    const auto large = allocator.allocate(size);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(large) % allocator_type::huge_page_size == 0);
+    large[0]        = 1.0f;
+    large[size - 1] = 2.0f;
+    REQUIRE(large[0] + large[size - 1] == 3.0f);
+    allocator.deallocate(large, size);
+  }
+
+  // Container tests.
+  {
+    using vector_type = multi::vector<float, 3, std::experimental::layout_right, std::experimental::default_accessor<float>, allocator_type>;
+
+    vector_type vector1({64, 64, 256}, 1.0f);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(vector1.data()) % allocator_type::huge_page_size == 0);
+    REQUIRE(vector1.at(63, 63, 255) == 1.0f);
+
+    vector_type vector2(std::move(vector1));
+    REQUIRE(vector2.at(0, 0, 0) == 1.0f);
+    vector1 = vector2;
+    REQUIRE(vector1 == vector2);
+  }
+}
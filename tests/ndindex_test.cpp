@@ -0,0 +1,93 @@
+#include "internal/doctest.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+#include <multi/array.hpp>
+#include <multi/ndindex.hpp>
+#include <multi/vector.hpp>
+
+TEST_CASE("multi::ndindex")
+{
+  using range_type = multi::ndindex_range<3>;
+  static_assert(std::ranges::random_access_range<range_type>);
+  static_assert(std::ranges::sized_range        <range_type>);
+  static_assert(std::ranges::view               <range_type>);
+  static_assert(std::ranges::random_access_range<multi::vector<int, 2>::indexed_type>);
+  static_assert(std::ranges::random_access_range<multi::vector<int, 2>::const_indexed_type>);
+
+  // Coordinate tests.
+  {
+    const auto range = multi::coords(std::array<std::size_t, 3> {2, 3, 4});
+    REQUIRE(range.size() == 24);
+
+    std::vector<std::array<std::size_t, 3>> positions;
+    for (const auto& position : range)
+      positions.push_back(position);
+    REQUIRE(positions.size() == 24);
+    REQUIRE(positions[ 0] == std::array<std::size_t, 3> {0, 0, 0});
+    REQUIRE(positions[ 1] == std::array<std::size_t, 3> {0, 0, 1});
+    REQUIRE(positions[ 4] == std::array<std::size_t, 3> {0, 1, 0});
+    REQUIRE(positions[23] == std::array<std::size_t, 3> {1, 2, 3});
+    REQUIRE(std::is_sorted(positions.begin(), positions.end()));
+
+    // Jumps agree with steps, in both directions.
+    auto iterator = range.end();
+    for (std::ptrdiff_t i = 23; i >= 0; --i)
+    {
+      --iterator;
+      REQUIRE(*iterator == positions[i]);
+      REQUIRE(range.begin()[i] == positions[i]);
+      REQUIRE(range.begin() + i == iterator);
+    }
+    REQUIRE(range.end() - range.begin() == 24);
+    REQUIRE(range.begin() < range.end());
+
+    const auto column_major = multi::coords(std::array<std::size_t, 3> {2, 3, 4}, {0, 1, 2});
+    REQUIRE(column_major.begin()[1] == std::array<std::size_t, 3> {1, 0, 0});
+    REQUIRE(column_major.begin()[2] == std::array<std::size_t, 3> {0, 1, 0});
+
+    REQUIRE(multi::coords(std::experimental::extents<std::experimental::dynamic_extent, 5>(2)).size() == 10);
+    REQUIRE(multi::coords(std::array<std::size_t, 2> {3, 0}).empty());
+  }
+
+  // Indexed tests.
+  {
+    multi::vector<int, 2> vector({3, 4}, 0);
+    for (auto [value, position] : vector.indexed())
+      value = static_cast<int>(position[0] * 10 + position[1]);
+    REQUIRE(vector(2, 3) == 23);
+    REQUIRE(vector.indexed().size() == 12);
+
+    // The traversal follows memory order.
+    const auto& const_vector = vector;
+    auto        expected     = vector.data();
+    for (const auto& [value, position] : const_vector.indexed())
+    {
+      static_assert(std::is_same_v<decltype(value), const int&>);
+      REQUIRE(&value == expected++);
+      REQUIRE(value  == static_cast<int>(position[0] * 10 + position[1]));
+    }
+
+    multi::vector<int, 2, std::experimental::layout_left> column_major({3, 4}, 0);
+    auto address = column_major.data();
+    for (auto [value, position] : column_major.indexed())
+    {
+      REQUIRE(&value == address++);
+      value = static_cast<int>(position[0] * 10 + position[1]);
+    }
+    REQUIRE(column_major.span()(2, 1) == 21);
+    REQUIRE(column_major.indexed().begin()[1].second == std::array<std::size_t, 2> {1, 0});
+
+    multi::array<int, multi::dimensions<2, 2>> array(1);
+    std::size_t count = 0;
+    for (const auto& [value, position] : array.indexed())
+      count += static_cast<std::size_t>(value);
+    REQUIRE(count == 4);
+  }
+}
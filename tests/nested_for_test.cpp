@@ -0,0 +1,69 @@
+#include "internal/doctest.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <multi/nested_for.hpp>
+#include <multi/vector.hpp>
+
+TEST_CASE("multi::nested_for")
+{
+  using position_type = std::array<std::size_t, 3>;
+
+  // Order tests.
+  {
+    std::vector<position_type> positions;
+    multi::nested_for<3>({2, 3, 4}, [&] (std::size_t i, std::size_t j, std::size_t k)
+    {
+      positions.push_back({i, j, k});
+    });
+    REQUIRE(positions.size() == 24);
+    REQUIRE(positions[1]  == position_type {0, 0, 1});
+    REQUIRE(positions[4]  == position_type {0, 1, 0});
+    REQUIRE(positions[23] == position_type {1, 2, 3});
+
+    positions.clear();
+    multi::nested_for<3, std::experimental::layout_left>({2, 3, 4}, [&] (const position_type& position)
+    {
+      positions.push_back(position);
+    });
+    REQUIRE(positions.size() == 24);
+    REQUIRE(positions[1]  == position_type {1, 0, 0});
+    REQUIRE(positions[2]  == position_type {0, 1, 0});
+    REQUIRE(positions[23] == position_type {1, 2, 3});
+  }
+
+  // Range tests.
+  {
+    std::size_t count = 0;
+    multi::nested_for<3>({1, 2, 3}, {2, 4, 6}, [&] (std::size_t i, std::size_t j, std::size_t k)
+    {
+      REQUIRE(i == 1);
+      REQUIRE((j >= 2 && j < 4));
+      REQUIRE((k >= 3 && k < 6));
+      ++count;
+    });
+    REQUIRE(count == 6);
+
+    multi::nested_for<3>({0, 2, 3}, [&] (const position_type&) { ++count; });
+    REQUIRE(count == 6);
+  }
+
+  // Memory order tests.
+  {
+    multi::vector<int, 3> vector({3, 4, 5}, 0);
+    auto                  address = vector.data();
+    multi::nested_for(vector.dimensions(), [&] (std::size_t i, std::size_t j, std::size_t k)
+    {
+      REQUIRE(&vector(i, j, k) == address++);
+    });
+
+    multi::vector<int, 3, std::experimental::layout_left> column_major({3, 4, 5}, 0);
+    address = column_major.data();
+    multi::nested_for<3, std::experimental::layout_left>(column_major.dimensions(), [&] (std::size_t i, std::size_t j, std::size_t k)
+    {
+      REQUIRE(&column_major(i, j, k) == address++);
+    });
+  }
+}
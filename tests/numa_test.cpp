@@ -0,0 +1,50 @@
+#include "internal/doctest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include <multi/numa.hpp>
+
+TEST_CASE("multi::numa")
+{
+  REQUIRE(multi::numa::node_count() >= 1);
+  REQUIRE(multi::numa::page_size () >= 1);
+  REQUIRE(!multi::numa::memory_nodes().empty());
+  REQUIRE(multi::numa::memory_nodes().size() <= multi::numa::node_count());
+  REQUIRE(std::is_sorted(multi::numa::memory_nodes().begin(), multi::numa::memory_nodes().end()));
+
+  // Allocation tests.
+  for (const auto placement : {multi::numa::placement::local, multi::numa::placement::first_touch, multi::numa::placement::interleaved})
+  {
+    using vector_type = multi::numa::vector<float, 2>;
+
+    const multi::numa::allocator<float> allocator(placement, multi::execution::parallel_policy {4});
+    vector_type vector1({300, 100}, 2.0f, allocator);
+    REQUIRE(vector1.get_allocator().placement() == placement);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(vector1.data()) % multi::numa::page_size() == 0);
+    for (std::size_t i = 0; i < vector1.size(); ++i)
+      REQUIRE(vector1.at(i) == 2.0f);
+
+    vector_type vector2(vector1);
+    REQUIRE(vector2 == vector1);
+    vector1.resize({400, 100}, 1.0f);
+    REQUIRE(vector1.at(399, 99) == 1.0f);
+
+    // Node query tests.
+    const auto ranges = multi::numa::outer_ranges(vector2);
+    REQUIRE(!ranges.empty());
+    REQUIRE(ranges.front().begin == 0);
+    REQUIRE(ranges.back ().end   == 300);
+    for (std::size_t i = 1; i < ranges.size(); ++i)
+    {
+      REQUIRE(ranges[i].begin == ranges[i - 1].end);
+      REQUIRE(ranges[i].node  != ranges[i - 1].node);
+    }
+    if (multi::numa::node_count() == 1 && ranges.front().node != -1)
+      REQUIRE(ranges.size() == 1);
+    for (const auto& range : ranges)
+      if (placement == multi::numa::placement::first_touch && range.node != -1)
+        REQUIRE(std::find(multi::numa::memory_nodes().begin(), multi::numa::memory_nodes().end(), std::size_t(range.node)) != multi::numa::memory_nodes().end());
+  }
+}
@@ -0,0 +1,91 @@
+#include "internal/doctest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <thread>
+
+#include <multi/profiling_accessor.hpp>
+
+TEST_CASE("multi::profiling_accessor")
+{
+  using accessor_type = multi::profiling_accessor<std::experimental::default_accessor<float>>;
+  using vector_type   = multi::vector<float, 2, std::experimental::layout_right, accessor_type>;
+
+  multi::profiling_settings settings;
+  settings.output = nullptr;
+
+  // Stride and reuse tests.
+  {
+    vector_type vector({8, 16}, 1.0f);
+    const auto  profiler = std::make_shared<multi::access_profiler>(vector.span().mapping(), settings);
+    vector.set_accessor(accessor_type(profiler));
+
+    float sum = 0.0f;
+    for (std::size_t i = 0; i < 8; ++i)
+      for (std::size_t j = 0; j < 16; ++j)
+        sum += vector(i, j);
+    REQUIRE(sum == 128.0f);
+
+    const auto report = profiler->report();
+    REQUIRE(report.access_count == 128);
+    REQUIRE(report.sample_count == 128);
+    REQUIRE(report.stride_histograms.size() == 2);
+    REQUIRE(report.stride_histograms[0].at( 0 ) == 120);
+    REQUIRE(report.stride_histograms[0].at( 1 ) == 7);
+    REQUIRE(report.stride_histograms[1].at( 1 ) == 120);
+    REQUIRE(report.stride_histograms[1].at(-15) == 7);
+    REQUIRE(report.cache_line_count >= 8);
+    REQUIRE(report.cache_line_count <= 9);
+    REQUIRE(report.cold_count == report.cache_line_count);
+    REQUIRE(report.reuse_distances.at(0) == 128 - report.cold_count);
+
+    std::uintptr_t first_line;
+    const auto heat_map = profiler->heat_map(&first_line);
+    REQUIRE(first_line <= reinterpret_cast<std::uintptr_t>(vector.data()));
+    REQUIRE(std::accumulate(heat_map.begin(), heat_map.end(), std::size_t(0)) == 128);
+
+    std::ostringstream stream;
+    multi::access_profiler::print(stream, report);
+    REQUIRE(stream.str().find("128 accesses") != std::string::npos);
+
+    // Copies share the profiler.
+    const auto copy = vector;
+    REQUIRE(copy(0, 0) == 1.0f);
+    REQUIRE(profiler->report().access_count == 129);
+
+    // Revisiting a line after touching others yields non-zero reuse distances.
+    static_cast<void>(vector(0, 0));
+    REQUIRE(profiler->report().reuse_distances.rbegin()->first >= 4);
+  }
+
+  // Sampling and thread tests.
+  {
+    settings.sampling_period = 4;
+    settings.burst_length    = 2;
+
+    vector_type vector({64, 64}, 1.0f);
+    const auto  profiler = std::make_shared<multi::access_profiler>(vector.span().mapping(), settings);
+    vector.set_accessor(accessor_type(profiler));
+
+    std::thread thread([&]
+    {
+      for (std::size_t i = 0; i < 32; ++i)
+        for (std::size_t j = 0; j < 64; ++j)
+          vector(i, j) = 2.0f;
+    });
+    for (std::size_t i = 32; i < 64; ++i)
+      for (std::size_t j = 0; j < 64; ++j)
+        vector(i, j) = 3.0f;
+    thread.join();
+
+    const auto report = profiler->report();
+    REQUIRE(report.access_count == 64 * 64);
+    REQUIRE(report.sample_count == 64 * 64 / 2);
+    REQUIRE(report.stride_histograms[1].at(1) == 64 * 64 / 4);
+    REQUIRE(vector(0, 0) == 2.0f);
+    REQUIRE(vector(63, 63) == 3.0f);
+  }
+}
@@ -0,0 +1,133 @@
+#include "internal/doctest.h"
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <multi/region_loader.hpp>
+
+namespace
+{
+struct detached
+{
+  struct promise_type
+  {
+    detached            get_return_object  () noexcept { return {}; }
+    std::suspend_never  initial_suspend    () noexcept { return {}; }
+    std::suspend_never  final_suspend      () noexcept { return {}; }
+    void                return_void        () noexcept { }
+    void                unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+template <typename _loader>
+detached load_async(const _loader& loader, typename _loader::box_type region, typename _loader::vector_type& result, std::atomic<bool>& done)
+{
+  result = co_await loader.load(region);
+  done   = true;
+  done.notify_all();
+}
+}
+
+TEST_CASE("multi::region_loader")
+{
+  using loader_type = multi::region_loader<std::uint32_t, 3>;
+
+  // The volume holds its linear indices, after a header of 16 bytes.
+  const loader_type::multi_size_type dimensions {6, 7, 9};
+  const auto path = (std::filesystem::temp_directory_path() / "multi_region_loader_test.raw").string();
+  {
+    std::ofstream stream(path, std::ios::binary);
+    const char header[16] {};
+    stream.write(header, sizeof header);
+    for (std::uint32_t i = 0; i < 6 * 7 * 9; ++i)
+      stream.write(reinterpret_cast<const char*>(&i), sizeof i);
+  }
+  const auto verify = [&] (const loader_type::box_type& region, const loader_type::vector_type& result)
+  {
+    for (auto i = region.begin[0]; i < region.end[0]; ++i)
+      for (auto j = region.begin[1]; j < region.end[1]; ++j)
+        for (auto k = region.begin[2]; k < region.end[2]; ++k)
+          if (result(i - region.begin[0], j - region.begin[1], k - region.begin[2]) != (i * 7 + j) * 9 + k)
+            return false;
+    return true;
+  };
+
+  for (const auto io_uring : {false, true})
+  {
+    multi::io_queue queue(4, 2, io_uring);
+    REQUIRE(queue.depth() == 4);
+
+    // Coalescing tests.
+    {
+      loader_type loader(path, dimensions, 16, queue);
+
+      const loader_type::box_type rows {{1, 2, 3}, {4, 6, 8}};
+      auto operation = loader.load(rows);
+      REQUIRE(operation.request_count() == 3 * 4);
+      const auto result = operation.get();
+      REQUIRE(result.dimensions() == loader_type::multi_size_type {3, 4, 5});
+      REQUIRE(verify(rows, result));
+
+      const loader_type::box_type slabs {{2, 0, 0}, {5, 7, 9}};
+      REQUIRE(loader.load(slabs).request_count() == 1);
+      REQUIRE(verify(slabs, loader.load(slabs).get()));
+
+      const loader_type::box_type planes {{0, 3, 0}, {6, 5, 9}};
+      REQUIRE(loader.load(planes).request_count() == 6);
+      REQUIRE(verify(planes, loader.load(planes).get()));
+
+      REQUIRE(loader.load({{1, 1, 1}, {1, 5, 5}}).get().empty());
+    }
+
+    // Request splitting tests.
+    {
+      loader_type loader(path, dimensions, 16, queue, 30);
+      REQUIRE(loader.request_size() == 28);
+
+      const loader_type::box_type all {{0, 0, 0}, dimensions};
+      auto operation = loader.load(all);
+      REQUIRE(operation.request_count() == (6 * 7 * 9 * 4 + 27) / 28);
+      REQUIRE(verify(all, operation.get()));
+    }
+
+    // Coroutine tests.
+    {
+      loader_type loader(path, dimensions, 16, queue, 64);
+
+      const loader_type::box_type regions[] {{{0, 0, 0}, {3, 3, 3}}, {{2, 1, 4}, {6, 7, 9}}, {{5, 6, 8}, {6, 7, 9}}};
+      loader_type::vector_type    results[3];
+      std::atomic<bool>           done   [3] {};
+      for (auto i = 0; i < 3; ++i)
+        load_async(loader, regions[i], results[i], done[i]);
+      for (auto i = 0; i < 3; ++i)
+      {
+        done[i].wait(false);
+        REQUIRE(verify(regions[i], results[i]));
+      }
+    }
+
+    // Error tests.
+    {
+      REQUIRE_THROWS_AS(loader_type(path + ".missing", dimensions, 0, queue), std::system_error);
+
+      loader_type loader(path, dimensions, 16, queue);
+      REQUIRE_THROWS_AS(loader.load({{0, 0, 0}, {7, 1, 1}}), std::out_of_range);
+      REQUIRE_THROWS_AS(loader.load({{2, 0, 0}, {1, 1, 1}}), std::out_of_range);
+
+      loader_type truncated(path, {7, 7, 9}, 16, queue);
+      REQUIRE_THROWS_AS(truncated.load({{5, 0, 0}, {7, 7, 9}}).get(), std::system_error);
+    }
+  }
+
+  std::remove(path.c_str());
+}
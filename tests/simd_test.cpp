@@ -0,0 +1,113 @@
+#include "internal/doctest.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <multi/simd.hpp>
+
+TEST_CASE("multi::simd")
+{
+  using multi::simd::instruction_set;
+
+  // Every path up to the detected one must agree with the scalar one. The sizes cover partial registers.
+  for (const auto limit : {instruction_set::scalar, instruction_set::sse4, instruction_set::avx2, instruction_set::avx512})
+  {
+    if (limit > multi::simd::detected_instruction_set())
+      break;
+    const auto previous = multi::simd::limit_instruction_set(limit);
+    REQUIRE(multi::simd::active_instruction_set() == limit);
+
+    for (const std::size_t size : {1, 7, 16, 33, 130})
+    {
+      // Fill and copy tests.
+      {
+        std::vector<std::int16_t> source(size), target(size, 0);
+        multi::simd::fill(source.data(), size, std::int16_t(-3));
+        for (const auto value : source)
+          REQUIRE(value == -3);
+
+        multi::simd::copy(source.data(), size, target.data());
+        REQUIRE(target == source);
+      }
+
+      // Compare tests.
+      {
+        std::vector<double> lhs(size, 1.5), rhs(size, 1.5);
+        REQUIRE(multi::simd::equal(lhs.data(), rhs.data(), size));
+        rhs[size - 1] = -0.0;
+        REQUIRE(!multi::simd::equal(lhs.data(), rhs.data(), size));
+        lhs[size - 1] = 0.0;
+        REQUIRE(multi::simd::equal(lhs.data(), rhs.data(), size));
+        lhs[0] = rhs[0] = std::numeric_limits<double>::quiet_NaN();
+        REQUIRE(!multi::simd::equal(lhs.data(), rhs.data(), size));
+        REQUIRE(multi::simd::mismatch(lhs.data(), rhs.data(), size) == 0);
+        lhs[0] = rhs[0] = 2.0;
+        REQUIRE(multi::simd::mismatch(lhs.data(), rhs.data(), size) == size);
+        rhs[size / 2] = 3.0;
+        REQUIRE(multi::simd::mismatch(lhs.data(), rhs.data(), size) == size / 2);
+      }
+
+      // Min/max and clamp tests.
+      {
+        std::vector<float> data(size);
+        for (std::size_t i = 0; i < size; ++i)
+          data[i] = static_cast<float>((i * 37) % 101) - 50.0f;
+        data[size / 2] = -100.0f;
+        data[size - 1] = 100.0f;
+        const auto [minimum, maximum] = multi::simd::minmax(data.data(), size);
+        REQUIRE(minimum == (size > 1 ? -100.0f : 100.0f));
+        REQUIRE(maximum == 100.0f);
+
+        multi::simd::clamp(data.data(), size, -10.0f, 10.0f);
+        for (const auto value : data)
+          REQUIRE((value >= -10.0f && value <= 10.0f));
+        REQUIRE(data[size - 1] == 10.0f);
+      }
+
+      // Conversion tests.
+      {
+        std::vector<float> source(size);
+        for (std::size_t i = 0; i < size; ++i)
+          source[i] = static_cast<float>(i) * 2.75f - 40.0f;
+        source[0] = std::numeric_limits<float>::quiet_NaN();
+        if (size > 1)
+          source[1] = 1e30f;
+
+        std::vector<std::uint8_t> bytes(size);
+        multi::simd::convert(source.data(), size, bytes.data());
+        std::vector<std::int32_t> integers(size);
+        multi::simd::convert(source.data(), size, integers.data());
+        REQUIRE(bytes   [0] == 0);
+        REQUIRE(integers[0] == 0);
+        if (size > 1)
+        {
+          REQUIRE(bytes   [1] == 255);
+          REQUIRE(integers[1] == std::numeric_limits<std::int32_t>::max());
+        }
+        for (std::size_t i = 2; i < size; ++i)
+        {
+          REQUIRE(bytes   [i] == static_cast<std::uint8_t>(std::clamp(source[i], 0.0f, 255.0f)));
+          REQUIRE(integers[i] == static_cast<std::int32_t>(source[i]));
+        }
+
+        std::vector<std::int32_t> wide(size);
+        for (std::size_t i = 0; i < size; ++i)
+          wide[i] = static_cast<std::int32_t>(i * 1000) - 40000;
+        std::vector<std::int16_t> narrow(size);
+        multi::simd::convert(wide.data(), size, narrow.data());
+        for (std::size_t i = 0; i < size; ++i)
+          REQUIRE(narrow[i] == std::clamp(wide[i], -32768, 32767));
+
+        std::vector<double> doubles(size);
+        multi::simd::convert(wide.data(), size, doubles.data());
+        for (std::size_t i = 0; i < size; ++i)
+          REQUIRE(doubles[i] == static_cast<double>(wide[i]));
+      }
+    }
+
+    multi::simd::limit_instruction_set(previous);
+  }
+}
@@ -0,0 +1,87 @@
+#include "internal/doctest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+
+#include <multi/soa_vector.hpp>
+
+TEST_CASE("multi::soa_vector")
+{
+  using vector_type = multi::soa_vector<std::tuple<float, std::int32_t, double>, 3>;
+
+  // Constructor tests.
+  {
+    vector_type constructor1;
+    REQUIRE(constructor1.empty());
+
+    vector_type constructor2({2, 3, 4}, {1.0f, 2, 3.0});
+    REQUIRE(constructor2.size() == 24);
+    REQUIRE(constructor2.dimensions() == vector_type::multi_size_type {2, 3, 4});
+    REQUIRE(constructor2(1, 2, 3) == std::tuple(1.0f, 2, 3.0));
+
+    vector_type constructor3(constructor2);
+    REQUIRE(constructor3 == constructor2);
+
+    vector_type constructor4(std::move(constructor3));
+    REQUIRE(constructor4 == constructor2);
+    REQUIRE(constructor3.empty());
+  }
+
+  // Element access tests.
+  {
+    vector_type vector({2, 3, 4});
+
+    vector(1, 2, 3) = std::tuple(1.0f, 2, 3.0);
+    auto [x, y, z] = vector({0, 1, 2});
+    x = 4.0f;
+    y = 5;
+    z = 6.0;
+    std::get<1>(vector.at(1, 0, 0)) = 7;
+
+    const auto& const_vector = vector;
+    REQUIRE(const_vector(1, 2, 3)      == std::tuple(1.0f, 2, 3.0));
+    REQUIRE(const_vector[{0, 1, 2}]    == std::tuple(4.0f, 5, 6.0));
+    REQUIRE(std::get<1>(const_vector.at(1, 0, 0)) == 7);
+    REQUIRE_THROWS_AS(const_vector.at(2, 0, 0), std::out_of_range);
+  }
+
+  // Field tests.
+  {
+    vector_type vector({2, 3, 4});
+    vector(1, 2, 3) = std::tuple(1.0f, 2, 3.0);
+
+    auto field0 = vector.field<0>();
+    auto field2 = vector.field<2>();
+    REQUIRE(field0(1, 2, 3) == 1.0f);
+    REQUIRE(field2(1, 2, 3) == 3.0);
+
+    field0(0, 0, 0) = 8.0f;
+    REQUIRE(std::get<0>(vector(0, 0, 0)) == 8.0f);
+    REQUIRE(vector.data<0>()[0] == 8.0f);
+    REQUIRE(vector.data<1>()[23] == 2);
+
+    const auto& const_vector = vector;
+    REQUIRE(const_vector.field<1>()(1, 2, 3) == 2);
+    REQUIRE(const_vector.field<1>().extent(2) == 4);
+  }
+
+  // Modifier tests.
+  {
+    vector_type vector1({2, 2, 2}, {1.0f, 1, 1.0});
+    vector1.resize({3, 3, 3}, {2.0f, 2, 2.0});
+    REQUIRE(vector1.size() == 27);
+    REQUIRE(vector1.dimensions() == vector_type::multi_size_type {3, 3, 3});
+    REQUIRE(std::get<0>(vector1(2, 2, 2)) == 2.0f);
+
+    vector_type vector2;
+    multi::swap(vector1, vector2);
+    REQUIRE(vector1.empty());
+    REQUIRE(vector2.size() == 27);
+
+    vector2.clear();
+    REQUIRE(vector2.empty());
+    REQUIRE(vector2.dimensions() == vector_type::multi_size_type {0, 0, 0});
+  }
+}
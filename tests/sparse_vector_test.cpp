@@ -0,0 +1,131 @@
+#include "internal/doctest.h"
+
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+
+#include <multi/sparse_vector.hpp>
+
+TEST_CASE("multi::sparse_vector")
+{
+  using vector_type = multi::sparse_vector<float, 3, 4>;
+
+  // Constructor tests.
+  {
+    vector_type constructor1;
+    REQUIRE(constructor1.empty());
+    REQUIRE(constructor1.block_count() == 0);
+
+    vector_type constructor2({64, 64, 64}, 1.0f);
+    REQUIRE(constructor2.size() == 64 * 64 * 64);
+    REQUIRE(constructor2.block_count() == 0);
+    REQUIRE(constructor2.background() == 1.0f);
+
+    constructor2(1, 2, 3) = 2.0f;
+    vector_type constructor3(constructor2);
+    REQUIRE(constructor3.block_count() == 1);
+    REQUIRE(constructor3.value({1, 2, 3}) == 2.0f);
+
+    vector_type constructor4(std::move(constructor3));
+    REQUIRE(constructor4.block_count() == 1);
+    REQUIRE(constructor4.value({1, 2, 3}) == 2.0f);
+    REQUIRE(constructor3.block_count() == 0);
+  }
+
+  // Element access tests.
+  {
+    vector_type vector({64, 64, 64}, -1.0f);
+    const auto& const_vector = vector;
+
+    REQUIRE(const_vector(10, 20, 30) == -1.0f);
+    REQUIRE(vector.value({10, 20, 30}) == -1.0f);
+    REQUIRE(vector.block_count() == 0);
+
+    vector(10, 20, 30) = 5.0f;
+    REQUIRE(vector.block_count() == 1);
+    REQUIRE(vector.active({10, 20, 30}));
+    REQUIRE(vector.active({11, 21, 31}));
+    REQUIRE(!vector.active({14, 20, 30}));
+    REQUIRE(const_vector(10, 20, 30)    == 5.0f);
+    REQUIRE(const_vector({11, 21, 31}) == -1.0f);
+    REQUIRE(vector.at(10, 20, 30)       == 5.0f);
+    REQUIRE(vector[{10, 20, 30}]        == 5.0f);
+
+    REQUIRE_THROWS_AS(vector.at(64, 0, 0), std::out_of_range);
+    REQUIRE(vector.block_position({10, 20, 30}) == vector_type::multi_size_type {2, 5, 7});
+    REQUIRE(vector.block_offset  ({10, 20, 30}) == vector_type::multi_size_type {2, 0, 2});
+  }
+
+  // Block tests.
+  {
+    vector_type vector({64, 64, 64});
+    vector(0 , 0 , 0 ) = 1.0f;
+    vector(63, 63, 63) = 1.0f;
+    vector(32, 0 , 16) = 1.0f;
+    REQUIRE(vector.block_count() == 3);
+    REQUIRE(vector.active_size() == 3 * 4 * 4 * 4);
+    REQUIRE(vector_type::block_dimensions() == vector_type::multi_size_type {4, 4, 4});
+
+    std::size_t count = 0;
+    vector.for_each_block([&] (const auto&, auto& block)
+    {
+      count += static_cast<std::size_t>(std::accumulate(block.begin(), block.end(), 0.0f));
+    });
+    REQUIRE(count == 3);
+
+    vector.for_each_block(multi::execution::par, [&] (const auto&, auto& block)
+    {
+      for (auto& element : block)
+        element += 1.0f;
+    });
+    REQUIRE(vector.value({0 , 0 , 0 }) == 2.0f);
+    REQUIRE(vector.value({1 , 1 , 1 }) == 1.0f);
+    REQUIRE(vector.value({62, 62, 62}) == 1.0f);
+    REQUIRE(vector.value({8 , 8 , 8 }) == 0.0f);
+
+    vector.for_each_block(multi::execution::par, [&] (const auto&, auto& block)
+    {
+      block.fill(0.0f);
+    });
+    vector(63, 63, 63) = 3.0f;
+    vector.prune(multi::execution::par);
+    REQUIRE(vector.block_count() == 1);
+    REQUIRE(vector.value({63, 63, 63}) == 3.0f);
+
+    vector.deactivate(vector.block_position({63, 63, 63}));
+    REQUIRE(vector.block_count() == 0);
+    REQUIRE(vector.find_block({15, 15, 15}) == nullptr);
+  }
+
+  // Modifier tests.
+  {
+    vector_type vector1({64, 64, 64});
+    vector1(0 , 0 , 0 ) = 1.0f;
+    vector1(40, 40, 40) = 1.0f;
+
+    vector1.resize({32, 32, 32});
+    REQUIRE(vector1.size() == 32 * 32 * 32);
+    REQUIRE(vector1.block_count() == 1);
+
+    vector_type vector2({8, 8, 8}, 2.0f);
+    multi::swap(vector1, vector2);
+    REQUIRE(vector1.background() == 2.0f);
+    REQUIRE(vector1.block_count() == 0);
+    REQUIRE(vector2.block_count() == 1);
+
+    vector2.clear();
+    REQUIRE(vector2.block_count() == 0);
+    REQUIRE(vector2.size() == 32 * 32 * 32);
+
+    vector_type vector3({32, 32, 32}, 2.0f);
+    vector3(29, 29, 29) = 1.0f;
+    vector3(31, 29, 29) = 1.0f;
+    vector3(29, 31, 31) = 1.0f;
+    vector3.resize({30, 30, 30});
+    vector3.resize({32, 32, 32});
+    REQUIRE(vector3.block_count() == 1);
+    REQUIRE(vector3.value({29, 29, 29}) == 1.0f);
+    REQUIRE(vector3.value({31, 29, 29}) == 2.0f);
+    REQUIRE(vector3.value({29, 31, 31}) == 2.0f);
+  }
+}
@@ -0,0 +1,88 @@
+#include "internal/doctest.h"
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <multi/atomic_accessor.hpp>
+#include <multi/thread_pool.hpp>
+
+TEST_CASE("multi::thread_pool")
+{
+  // Box tests.
+  {
+    multi::box<2> box {{0, 0}, {4, 10}};
+    REQUIRE(box.size() == 40);
+    const auto upper = box.split();
+    REQUIRE(box  .end  [1] == 5);
+    REQUIRE(upper.begin[1] == 5);
+    REQUIRE(box.size() + upper.size() == 40);
+    REQUIRE(multi::box<2> {{3, 0}, {3, 5}}.empty());
+  }
+
+  multi::thread_pool pool(3);
+  REQUIRE(pool.thread_count() == 3);
+
+  // Parallel for tests.
+  {
+    std::vector<std::atomic<int>> visits(37 * 23);
+    std::atomic<std::size_t>      leaves {0};
+    pool.parallel_for(multi::box<2> {{0, 0}, {37, 23}}, 16, [&] (const multi::box<2>& leaf)
+    {
+      REQUIRE(leaf.size() <= 16);
+      ++leaves;
+      for (auto i = leaf.begin[0]; i < leaf.end[0]; ++i)
+        for (auto j = leaf.begin[1]; j < leaf.end[1]; ++j)
+          ++visits[i * 23 + j];
+    });
+    for (const auto& visit : visits)
+      REQUIRE(visit == 1);
+    REQUIRE(leaves > 1);
+
+    // Nested.
+    std::atomic<std::size_t> count {0};
+    pool.parallel_for(multi::box<1> {{0}, {8}}, 1, [&] (const multi::box<1>&)
+    {
+      pool.parallel_for(multi::box<3> {{0, 0, 0}, {4, 4, 4}}, 8, [&] (const multi::box<3>& leaf)
+      {
+        count += leaf.size();
+      });
+    });
+    REQUIRE(count == 8 * 64);
+
+    // Exceptions.
+    std::atomic<std::size_t> processed {0};
+    REQUIRE_THROWS_AS(pool.parallel_for(multi::box<1> {{0}, {100}}, 1, [&] (const multi::box<1>& leaf)
+    {
+      ++processed;
+      if (leaf.begin[0] == 42)
+        throw std::runtime_error("leaf");
+    }), std::runtime_error);
+    REQUIRE(processed == 100);
+  }
+
+  // Policy tests.
+  {
+    const multi::execution::pool_policy policy {&pool};
+    REQUIRE(multi::concurrency(policy) == 4);
+
+    std::vector<int> values(1000, 0);
+    multi::for_each_index(policy, values.size(), [&] (const std::size_t i)
+    {
+      values[i] += static_cast<int>(i);
+    });
+    for (std::size_t i = 0; i < values.size(); ++i)
+      REQUIRE(values[i] == static_cast<int>(i));
+
+    multi::vector<int, 2> histogram({8, 8}, 0);
+    multi::scatter_add<4>(histogram, 6400, [ ] (const std::size_t i, auto&& add)
+    {
+      add({i % 8, (i / 8) % 8}, 1);
+    }, policy);
+    for (const auto value : histogram)
+      REQUIRE(value == 100);
+
+    REQUIRE(multi::default_thread_pool().thread_count() >= 1);
+  }
+}
@@ -0,0 +1,114 @@
+#include "internal/doctest.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <multi/triple_buffer.hpp>
+
+TEST_CASE("multi::triple_buffer")
+{
+  using buffer_type = multi::triple_buffer<std::uint16_t, 2>;
+
+  // Hand-off tests.
+  {
+    buffer_type buffer({4, 8}, 0);
+    REQUIRE(buffer.slot_count() == 3);
+    REQUIRE(!buffer.acquire_latest_read());
+
+    auto writer = buffer.acquire_write();
+    REQUIRE(writer);
+    REQUIRE(writer->dimensions() == buffer_type::multi_size_type {4, 8});
+    (*writer)(3, 7) = 1;
+    REQUIRE(buffer.publish(std::move(writer)) == 1);
+    REQUIRE(!writer);
+
+    auto reader1 = buffer.acquire_latest_read();
+    REQUIRE(reader1);
+    REQUIRE(reader1.epoch() == 1);
+    REQUIRE((*reader1)(3, 7) == 1);
+
+    // The reader keeps its epoch alive while newer ones are published.
+    for (std::uint16_t i = 2; i < 6; ++i)
+    {
+      auto next = buffer.acquire_write();
+      REQUIRE(next);
+      REQUIRE(&*next != &*reader1);
+      next->at(0, 0) = i;
+      buffer.publish(std::move(next));
+    }
+    REQUIRE(reader1.epoch() == 1);
+    REQUIRE((*reader1)(3, 7) == 1);
+
+    // With every other slot held, the writer fails without blocking.
+    auto reader2 = buffer.acquire_latest_read();
+    REQUIRE(reader2.epoch() == 5);
+    REQUIRE(reader2->at(0, 0) == 5);
+    REQUIRE(buffer.publish(buffer.acquire_write()) == 6);
+    REQUIRE(!buffer.acquire_write());
+    REQUIRE(buffer.publish(buffer.acquire_write()) == 0);
+    REQUIRE(buffer.epoch() == 6);
+    REQUIRE(buffer.acquire_latest_read().epoch() == 6);
+
+    reader1.reset();
+    auto abandoned = buffer.acquire_write();
+    REQUIRE(abandoned);
+    abandoned.reset();
+    REQUIRE(buffer.acquire_write());
+    REQUIRE(buffer.epoch() == 6);
+  }
+
+  // Concurrency tests: every frame is written uniformly, so torn reads would show mixed values. Every other frame is
+  // preceded by a write scribbled over and abandoned, usually on the previous slot while readers acquire it.
+  for (const std::size_t slot_count : {3, 4})
+  {
+    buffer_type buffer({64, 64}, 0, slot_count);
+
+    std::atomic<bool> done {false};
+    std::atomic<int>  failures {0};
+    std::vector<std::thread> readers;
+    for (auto i = 0; i < 2; ++i)
+      readers.emplace_back([&]
+      {
+        buffer_type::epoch_type last = 0;
+        while (!done)
+        {
+          const auto reader = buffer.acquire_latest_read();
+          if (!reader)
+            continue;
+          if (reader.epoch() < last)
+            ++failures;
+          last = reader.epoch();
+          for (const auto value : *reader)
+            if (value != static_cast<std::uint16_t>(reader.epoch()))
+              ++failures;
+        }
+      });
+
+    std::size_t published = 0;
+    while (published < 2000)
+    {
+      if (published % 2 == 1)
+        if (auto abandoned = buffer.acquire_write())
+          (*abandoned)(0, 0) = 0xFFFF;
+
+      auto writer = buffer.acquire_write();
+      if (!writer)
+        continue;
+      const auto value = static_cast<std::uint16_t>(buffer.epoch() + 1);
+      for (auto& element : *writer)
+        element = value;
+      buffer.publish(std::move(writer));
+      ++published;
+    }
+    done = true;
+    for (auto& reader : readers)
+      reader.join();
+
+    REQUIRE(failures == 0);
+    REQUIRE(buffer.epoch() == 2000);
+  }
+}
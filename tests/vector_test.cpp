@@ -1,7 +1,11 @@
 #include "internal/doctest.h"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <multi/vector.hpp>
@@ -428,4 +432,114 @@ TEST_CASE("multi::vector")
         REQUIRE(vector3.at(i) == static_cast<float>(i));
     }
   }
+  // Polymorphic allocator.
+  {
+    using vector_type = multi::pmr::vector<float, 2>;
+
+    std::pmr::monotonic_buffer_resource resource1;
+    std::pmr::monotonic_buffer_resource resource2;
+
+    // Copy, move and swap tests.
+    {
+      vector_type vector1 ({2, 3}, 1.0f, &resource1);
+      REQUIRE(vector1.get_allocator().resource() == &resource1);
+
+      vector_type copy1 (vector1);
+      REQUIRE(copy1.get_allocator().resource() == std::pmr::get_default_resource());
+      vector_type copy2 (vector1, &resource2);
+      REQUIRE(copy2.get_allocator().resource() == &resource2);
+      REQUIRE(copy2 == vector1);
+
+      vector_type moved1 (std::move(copy2));
+      REQUIRE(moved1.get_allocator().resource() == &resource2);
+      REQUIRE(copy2 .get_allocator().resource() == &resource2);
+      REQUIRE(copy2 .empty());
+      REQUIRE(moved1 == vector1);
+
+      vector_type moved2 (std::move(moved1), &resource1);
+      REQUIRE(moved2.get_allocator().resource() == &resource1);
+      REQUIRE(moved1.get_allocator().resource() == &resource2);
+      REQUIRE(moved1.empty());
+      REQUIRE(moved2 == vector1);
+
+      vector_type assigned ({1, 1}, 0.0f, &resource2);
+      assigned = vector1;
+      REQUIRE(assigned.get_allocator().resource() == &resource2);
+      REQUIRE(assigned == vector1);
+      assigned = std::move(moved2);
+      REQUIRE(assigned.get_allocator().resource() == &resource2);
+      REQUIRE(moved2  .get_allocator().resource() == &resource1);
+      REQUIRE(moved2  .empty());
+      REQUIRE(assigned == vector1);
+
+      vector_type vector2 ({3, 2}, 2.0f, &resource1);
+      vector1.swap(vector2);
+      REQUIRE(vector1.dimensions() == vector_type::multi_size_type {3, 2});
+      REQUIRE(vector2.dimensions() == vector_type::multi_size_type {2, 3});
+      REQUIRE(vector1.at(0, 0) == 2.0f);
+      REQUIRE(vector2.at(0, 0) == 1.0f);
+    }
+  }
+  // Mixed static and dynamic extents.
+  {
+    using extents_type = std::experimental::extents<std::experimental::dynamic_extent, 3, std::experimental::dynamic_extent, 4>;
+    using vector_type  = multi::mixed_vector<float, extents_type>;
+    static_assert(std::is_same_v<vector_type::dynamic_size_type, std::array<std::size_t, 2>>);
+    static_assert(vector_type::span_type::static_extent(3) == 4);
+
+    // Constructor tests.
+    {
+      vector_type vector1;
+      REQUIRE(vector1.dimensions() == vector_type::multi_size_type {0, 3, 0, 4});
+      REQUIRE(vector1.empty());
+
+      vector_type vector2 ({2, 5}, 1.0f);
+      REQUIRE(vector2.dimensions() == vector_type::multi_size_type {2, 3, 5, 4});
+      REQUIRE(vector2.size() == 120);
+      REQUIRE(vector2.span().mapping().stride(2) == 4);
+      vector2(1, 2, 4, 3) = 2.0f;
+      REQUIRE(vector2.back() == 2.0f);
+    }
+
+    // Modifier tests.
+    {
+      vector_type vector1 ({1, 1}, 0.0f);
+      vector1.reserve({4, 4});
+      REQUIRE(vector1.capacity() >= 4 * 3 * 4 * 4);
+      vector1.resize({4, 4}, 1.0f);
+      REQUIRE(vector1.dimensions() == vector_type::multi_size_type {4, 3, 4, 4});
+      REQUIRE(vector1.size() == 192);
+      vector1.assign({2, 2}, 3.0f);
+      REQUIRE(vector1.size() == 48);
+      REQUIRE(vector1(1, 2, 1, 3) == 3.0f);
+      vector1.clear();
+      REQUIRE(vector1.dimensions() == vector_type::multi_size_type {0, 3, 0, 4});
+
+      vector_type vector2 ({2, 2}, 3.0f);
+      REQUIRE(vector2 == vector_type({2, 2}, 3.0f));
+      multi::swap(vector1, vector2);
+      REQUIRE(vector1.size() == 48);
+    }
+  }
+  // Fully static extents.
+  {
+    using vector_type = multi::mixed_vector<int, std::experimental::extents<2, 3>>;
+
+    vector_type vector1;
+    REQUIRE(vector1.dimensions() == vector_type::multi_size_type {2, 3});
+    REQUIRE(vector1.size() == 6);
+    REQUIRE(vector1(1, 2) == 0);
+    vector1(1, 2) = 5;
+    REQUIRE(vector1.back() == 5);
+
+    vector_type vector2(std::move(vector1));
+    REQUIRE(vector2(1, 2) == 5);
+    REQUIRE(vector1.size() == 6);
+    REQUIRE(vector1(1, 2) == 0);
+
+    vector2.clear();
+    REQUIRE(vector2.size() == 6);
+    REQUIRE(vector2.dimensions() == vector_type::multi_size_type {2, 3});
+    REQUIRE(vector2(1, 2) == 0);
+  }
 }
\ No newline at end of file
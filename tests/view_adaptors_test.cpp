@@ -0,0 +1,148 @@
+#include "internal/doctest.h"
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <multi/execution.hpp>
+#include <multi/vector.hpp>
+#include <multi/view.hpp>
+#include <multi/view_adaptors.hpp>
+
+template <typename _operand>
+concept adaptable = requires (_operand&& operand)
+{
+  multi::flip(std::forward<_operand>(operand));
+  multi::stride(std::forward<_operand>(operand), {1, 1});
+  multi::reverse(std::forward<_operand>(operand), 0);
+};
+template <typename _lhs, typename _rhs>
+concept zippable  = requires (_lhs&& lhs, _rhs&& rhs)
+{
+  multi::zip(std::forward<_lhs>(lhs), std::forward<_rhs>(rhs));
+  multi::transform(std::plus(), std::forward<_lhs>(lhs), std::forward<_rhs>(rhs));
+};
+
+TEST_CASE("multi::view_adaptors")
+{
+  multi::vector<float, 2> a({4, 6}, 0.0f), b({4, 6}, 0.0f);
+  for (std::size_t i = 0; i < 4; ++i)
+    for (std::size_t j = 0; j < 6; ++j)
+    {
+      a(i, j) = static_cast<float>(i * 6 + j);
+      b(i, j) = static_cast<float>(j * j);
+    }
+
+  // Transform tests.
+  {
+    const auto difference = multi::transform([] (float lhs, float rhs) { return std::abs(lhs - rhs); }, a, b);
+    REQUIRE(difference.rank() == 2);
+    REQUIRE(difference.dimensions() == multi::vector<float, 2>::multi_size_type {4, 6});
+    REQUIRE(difference.size() == 24);
+    REQUIRE(difference(1, 5) == 14.0f);
+    REQUIRE(difference[{3, 2}] == 16.0f);
+
+    const auto doubled = multi::transform(std::negate(), difference);
+    REQUIRE(doubled(1, 5) == -14.0f);
+
+    const auto evaluated = multi::evaluate(difference);
+    static_assert(std::is_same_v<std::remove_cvref_t<decltype(evaluated)>, multi::vector<float, 2>>);
+    REQUIRE(evaluated(1, 5) == 14.0f);
+    REQUIRE(evaluated(3, 5) == 2.0f);
+    REQUIRE(multi::evaluate(difference, multi::execution::parallel_policy {3}) == evaluated);
+
+    const multi::vector<float, 2> mismatched({4, 5}, 0.0f);
+    REQUIRE_THROWS_AS(multi::transform(std::plus(), a, mismatched), std::invalid_argument);
+  }
+
+  // Zip tests.
+  {
+    const auto zipped = multi::zip(a, b);
+    const auto [first, second] = zipped(2, 3);
+    REQUIRE(first  == 15.0f);
+    REQUIRE(second == 9.0f);
+
+    // Elements of containers are zipped by reference.
+    std::get<1>(zipped(0, 0)) = 100.0f;
+    REQUIRE(b(0, 0) == 100.0f);
+    b(0, 0) = 0.0f;
+
+    const auto maximum = multi::transform([] (const auto& pair) { return std::max(std::get<0>(pair), std::get<1>(pair)); }, zipped);
+    REQUIRE(maximum(0, 5) == 25.0f);
+    REQUIRE(maximum(3, 5) == 25.0f);
+
+    // Zips evaluate to tuples of values.
+    const auto pairs = multi::evaluate(multi::zip(a, b));
+    static_assert(std::is_same_v<std::remove_cvref_t<decltype(pairs)>, multi::vector<std::tuple<float, float>, 2>>);
+    REQUIRE(pairs(2, 3) == std::tuple(15.0f, 9.0f));
+
+    // Elements of const containers are zipped by const reference.
+    const auto& constant = b;
+    static_assert(std::is_same_v<decltype(multi::zip(a, constant)(0, 0)), std::tuple<float&, const float&>>);
+  }
+
+  // Stride, reverse and flip tests.
+  {
+    const auto strided = multi::stride(a, {2, 4});
+    REQUIRE(strided.dimensions() == multi::vector<float, 2>::multi_size_type {2, 2});
+    REQUIRE(strided(1, 1) == a(2, 4));
+    REQUIRE_THROWS_AS(multi::stride(a, {0, 1}), std::invalid_argument);
+
+    const auto reversed = multi::reverse(a, 1);
+    REQUIRE(reversed(0, 0) == a(0, 5));
+    REQUIRE(reversed(3, 1) == a(3, 4));
+    REQUIRE_THROWS_AS(multi::reverse(a, 2), std::out_of_range);
+
+    const auto flipped = multi::flip(a);
+    REQUIRE(flipped(0, 0) == a(3, 5));
+    REQUIRE(multi::evaluate(multi::flip(flipped)) == a);
+
+    // Composition: every other column of the reversed rows, doubled.
+    const auto composed = multi::transform([] (float value) { return 2.0f * value; }, multi::stride(multi::reverse(a, 0), {1, 2}));
+    REQUIRE(composed.dimensions() == multi::vector<float, 2>::multi_size_type {4, 3});
+    REQUIRE(composed(0, 2) == 2.0f * a(3, 4));
+
+    // Writing through views of containers.
+    multi::vector<float, 2> target({4, 6}, 0.0f);
+    multi::copy(a, multi::flip(target));
+    REQUIRE(target(0, 0) == a(3, 5));
+    REQUIRE(target(3, 5) == a(0, 0));
+
+    // Views of const containers are read-only.
+    const auto& constant = target;
+    static_assert(std::is_same_v<decltype(multi::flip(constant)(0, 0)), const float&>);
+    static_assert(std::is_same_v<decltype(multi::stride(constant, {1, 1})(0, 0)), const float&>);
+    REQUIRE(multi::evaluate(multi::flip(constant)) == a);
+
+    // Spans and views are operands too.
+    const multi::view<const float, 2> view = a;
+    REQUIRE(multi::reverse(view, 0)(0, 0) == a(3, 0));
+    REQUIRE(multi::reverse(a.span(), 0)(0, 0) == a(3, 0));
+    REQUIRE(multi::flip(multi::view<const float, 2>(a))(0, 0) == a(3, 5));
+
+    // Temporary containers would be destroyed while the views refer to them.
+    using vector_type = multi::vector<float, 2>;
+    static_assert( adaptable<      vector_type&>);
+    static_assert( adaptable<const vector_type&>);
+    static_assert(!adaptable<      vector_type >);
+    static_assert(!adaptable<const vector_type >);
+    static_assert( adaptable<multi::view<float, 2>>);
+    static_assert( adaptable<vector_type::span_type>);
+    static_assert( adaptable<decltype(multi::flip(a))>);
+    static_assert( zippable <vector_type&, const vector_type&>);
+    static_assert(!zippable <vector_type&, vector_type>);
+    static_assert(!zippable <vector_type , vector_type&>);
+  }
+
+  // 1D tests.
+  {
+    multi::vector<int, 1> line {1, 2, 3, 4, 5};
+    const auto evaluated = multi::evaluate(multi::transform([] (int value) { return value * value; }, multi::reverse(line, 0)));
+    REQUIRE(evaluated == multi::vector<int, 1> {25, 16, 9, 4, 1});
+    REQUIRE(multi::stride(line, {2})(2) == 5);
+  }
+}
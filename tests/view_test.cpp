@@ -0,0 +1,119 @@
+#include "internal/doctest.h"
+
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <multi/algorithm.hpp>
+#include <multi/array.hpp>
+#include <multi/hash.hpp>
+#include <multi/vector.hpp>
+#include <multi/view.hpp>
+
+namespace
+{
+float sum(multi::view<const float, 2> view)
+{
+  return std::accumulate(view.begin(), view.end(), 0.0f);
+}
+}
+
+TEST_CASE("multi::view")
+{
+  // Constructor tests.
+  {
+    multi::view<float, 2> constructor1;
+    REQUIRE(constructor1.empty());
+    REQUIRE(constructor1.data() == nullptr);
+
+    std::vector<float> buffer(12);
+    std::iota(buffer.begin(), buffer.end(), 0.0f);
+    multi::view<float, 2> constructor2(buffer.data(), {3, 4});
+    REQUIRE(constructor2.size() == 12);
+    REQUIRE(constructor2.dimensions() == multi::view<float, 2>::multi_size_type {3, 4});
+    REQUIRE(constructor2(1, 2) == 6.0f);
+
+    multi::view<float, 1> constructor3(buffer.data(), 12);
+    REQUIRE(constructor3[11] == 11.0f);
+
+    multi::view<const float, 2> constructor4(constructor2);
+    REQUIRE(constructor4.data() == buffer.data());
+    REQUIRE(constructor4(2, 3) == 11.0f);
+
+    multi::view<float, 2> constructor5(constructor2.span());
+    REQUIRE(constructor5(2, 0) == 8.0f);
+  }
+
+  // Container conversion tests.
+  {
+    multi::vector<float, 2> vector({3, 4}, 1.0f);
+    REQUIRE(sum(vector) == 12.0f);
+
+    const multi::array<float, multi::dimensions<2, 2>> array(2.0f);
+    REQUIRE(sum(array) == 8.0f);
+
+    multi::view<float, 2> view = vector;
+    view(1, 1) = 5.0f;
+    REQUIRE(vector(1, 1) == 5.0f);
+    REQUIRE(view.data() == vector.data());
+
+    multi::view deduced(vector);
+    static_assert(std::is_same_v<decltype(deduced), multi::view<float, 2>>);
+    multi::view const_deduced(array);
+    static_assert(std::is_same_v<decltype(const_deduced), multi::view<const float, 2>>);
+
+    static_assert( std::is_convertible_v<multi::vector<float, 2>&      , multi::view<const float, 2>>);
+    static_assert(!std::is_convertible_v<const multi::vector<float, 2>&, multi::view<float, 2>>);
+    static_assert(!std::is_convertible_v<multi::vector<float, 3>&      , multi::view<float, 2>>);
+    static_assert(!std::is_convertible_v<multi::vector<float, 2, std::experimental::layout_left>&, multi::view<float, 2>>);
+
+    multi::vector<float, 2, std::experimental::layout_left> left({3, 4}, 0.0f);
+    multi::view<float, 2, std::experimental::layout_left> left_view = left;
+    left_view(2, 0) = 1.0f;
+    REQUIRE(left.data()[2] == 1.0f);
+  }
+
+  // Element access and iterator tests.
+  {
+    multi::vector<int, 2> vector({2, 3}, 0);
+    multi::view<int, 2>   view = vector;
+    std::iota(view.begin(), view.end(), 0);
+    REQUIRE(view.front() == 0);
+    REQUIRE(view.back () == 5);
+    REQUIRE(*view.rbegin() == 5);
+    REQUIRE(view.at(4) == 4);
+    REQUIRE(view.at(1, 2) == 5);
+    REQUIRE(view[{1, 0}] == 3);
+    REQUIRE_THROWS_AS(view.at(6)   , std::out_of_range);
+    REQUIRE_THROWS_AS(view.at(2, 0), std::out_of_range);
+
+    std::size_t count = 0;
+    for (const auto& [element, position] : view.indexed())
+    {
+      REQUIRE(element == static_cast<int>(position[0] * 3 + position[1]));
+      ++count;
+    }
+    REQUIRE(count == 6);
+  }
+
+  // Strided view and algorithm tests.
+  {
+    multi::vector<int, 2> vector({4, 6}, 0);
+    using stride_view = multi::view<int, 2, std::experimental::layout_stride>;
+    // Every other column.
+    const stride_view view(vector.data() + 1, stride_view::mapping_type(stride_view::extents_type(4, 3), std::array<std::size_t, 2> {6, 2}));
+    multi::fill(view, 7);
+    REQUIRE(vector(0, 1) == 7);
+    REQUIRE(vector(3, 5) == 7);
+    REQUIRE(vector(3, 4) == 0);
+    REQUIRE(view.at(3, 2) == 7);
+    REQUIRE(multi::minmax(view) == std::pair(7, 7));
+
+    multi::vector<int, 2> copy({4, 6}, 0);
+    multi::copy(multi::view<const int, 2>(vector), multi::view<int, 2>(copy));
+    REQUIRE(copy == vector);
+    REQUIRE(multi::equal(multi::view<int, 2>(copy), vector));
+    REQUIRE(multi::content_hash(multi::view<int, 2>(copy)) == multi::content_hash(vector));
+  }
+}